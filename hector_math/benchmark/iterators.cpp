@@ -1,14 +1,27 @@
 // Copyright (c) 2021 Stefan Fabian. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+#include "hector_math/iterators/cell_range.h"
+#include "hector_math/iterators/annulus_iterator.h"
 #include "hector_math/iterators/circle_iterator.h"
+#include "hector_math/iterators/circle_stencil.h"
+#include "hector_math/iterators/ellipse_iterator.h"
+#include "hector_math/iterators/line_iterator.h"
+#include "hector_math/iterators/multi_polygon_iterator.h"
+#include "hector_math/iterators/parallel_iterators.h"
+#include "hector_math/iterators/polygon_coverage_iterator.h"
 #include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/iterators/polygon_outline_iterator.h"
+#include "hector_math/iterators/polygon_raster_plan.h"
 #include "hector_math/iterators/rectangle_iterator.h"
+#include "hector_math/iterators/sector_iterator.h"
+#include "hector_math/iterators/swept_polygon_iterator.h"
 #include "iterators_input.h"
 
 #if BENCHMARK_ENABLE_GRIDMAP
 
 #include <grid_map_core/iterators/CircleIterator.hpp>
+#include <grid_map_core/iterators/LineIterator.hpp>
 #include <grid_map_core/iterators/PolygonIterator.hpp>
 
 #endif
@@ -32,6 +45,22 @@ static void rectangleIterator( benchmark::State &state )
 BENCHMARK_TEMPLATE( rectangleIterator, float )->Unit( benchmark::kMicrosecond );
 BENCHMARK_TEMPLATE( rectangleIterator, double )->Unit( benchmark::kMicrosecond );
 
+template<typename Scalar>
+static void rectangleSpanIterator( benchmark::State &state )
+{
+  GridMap<Scalar> map = GridMap<Scalar>::Zero( 20, 20 );
+
+  for ( auto _ : state ) {
+    iterateRectangleSpans<Scalar>(
+        Vector2<Scalar>( 0, 1 ), Vector2<Scalar>( 1, 19 ), Vector2<Scalar>( 18, 0 ),
+        [&map]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+          map.col( y ).segment( x_start, x_end - x_start ) += 1;
+        } );
+  }
+}
+BENCHMARK_TEMPLATE( rectangleSpanIterator, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( rectangleSpanIterator, double )->Unit( benchmark::kMicrosecond );
+
 template<typename Scalar>
 static void polygonIterator( benchmark::State &state )
 {
@@ -46,6 +75,406 @@ static void polygonIterator( benchmark::State &state )
 BENCHMARK_TEMPLATE( polygonIterator, float )->Unit( benchmark::kMicrosecond );
 BENCHMARK_TEMPLATE( polygonIterator, double )->Unit( benchmark::kMicrosecond );
 
+template<typename Scalar>
+static void polygonSpanIterator( benchmark::State &state )
+{
+  Polygon<Scalar> polygon = createPolygon<Scalar>();
+  GridMap<Scalar> map( 20, 20 );
+
+  for ( auto _ : state ) {
+    iteratePolygonSpans<Scalar>(
+        polygon / Scalar( 0.05 ), [&map]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+          map.col( y ).segment( x_start, x_end - x_start ) += 1;
+        } );
+  }
+}
+BENCHMARK_TEMPLATE( polygonSpanIterator, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( polygonSpanIterator, double )->Unit( benchmark::kMicrosecond );
+
+template<typename Scalar, int N>
+static Eigen::Array<Scalar, 2, N> createFootprint()
+{
+  // Regular N-gon with the size of a typical robot footprint
+  Eigen::Array<Scalar, 2, N> polygon;
+  for ( int i = 0; i < N; ++i ) {
+    const Scalar angle = Scalar( 2 * M_PI * i / N + 0.3 );
+    polygon.col( i ) << 10.1 + 8 * std::cos( angle ), 9.8 + 8 * std::sin( angle );
+  }
+  return polygon;
+}
+
+template<typename Scalar, int N>
+static void dynamicSizeFootprintIterator( benchmark::State &state )
+{
+  const Polygon<Scalar> polygon = createFootprint<Scalar, N>();
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iteratePolygonSpans<Scalar>(
+        polygon, 20, 20, [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+          count += x_end - x_start;
+        } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( dynamicSizeFootprintIterator, float, 4 );
+BENCHMARK_TEMPLATE( dynamicSizeFootprintIterator, float, 6 );
+BENCHMARK_TEMPLATE( dynamicSizeFootprintIterator, float, 8 );
+
+template<typename Scalar, int N>
+static void fixedSizeFootprintIterator( benchmark::State &state )
+{
+  const Eigen::Array<Scalar, 2, N> polygon = createFootprint<Scalar, N>();
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iteratePolygonSpans( polygon, 20, 20,
+                         [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+                           count += x_end - x_start;
+                         } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( fixedSizeFootprintIterator, float, 4 );
+BENCHMARK_TEMPLATE( fixedSizeFootprintIterator, float, 6 );
+BENCHMARK_TEMPLATE( fixedSizeFootprintIterator, float, 8 );
+
+template<typename Scalar>
+static void polygonRasterPlan( benchmark::State &state )
+{
+  PolygonRasterPlan plan( Polygon<Scalar>( createPolygon<Scalar>() / Scalar( 0.05 ) ) );
+  GridMap<Scalar> map( 40, 40 );
+
+  Eigen::Index offset = 0;
+  for ( auto _ : state ) {
+    // Replay at changing offsets as it would be used for collision checks at different positions
+    offset = ( offset + 1 ) % 20;
+    plan.iterate( offset, 20 - offset,
+                  [&map]( Eigen::Index x, Eigen::Index y ) { ++map( x, y ); } );
+  }
+}
+BENCHMARK_TEMPLATE( polygonRasterPlan, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( polygonRasterPlan, double )->Unit( benchmark::kMicrosecond );
+
+template<typename Scalar>
+static void largePolygonIterator( benchmark::State &state )
+{
+  Polygon<Scalar> polygon = createStarPolygon<Scalar>( state.range( 0 ), 200, 200 );
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iteratePolygonSpans<Scalar>(
+        polygon, [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+          count += x_end - x_start;
+        } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( largePolygonIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 100 )
+    ->Arg( 500 )
+    ->Arg( 2000 );
+BENCHMARK_TEMPLATE( largePolygonIterator, double )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 100 )
+    ->Arg( 500 )
+    ->Arg( 2000 );
+
+//! Queries of a star polygon with a radius of 100 cells at 100 positions around a 200x200 local map,
+//! hence, most queries are partially or entirely outside of the map. The argument is the number of
+//! vertices.
+template<typename Scalar>
+static void outOfBoundsPolygonIterator( benchmark::State &state )
+{
+  const Polygon<Scalar> star = createStarPolygon<Scalar>( state.range( 0 ), 100, 0 );
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> position_dist( -300, 500 );
+  std::vector<Polygon<Scalar>> polygons;
+  for ( int i = 0; i < 100; ++i ) {
+    polygons.push_back( star );
+    polygons.back().colwise() += Point<Scalar>( position_dist( gen ), position_dist( gen ) );
+  }
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    for ( const auto &polygon : polygons ) {
+      iteratePolygonSpans<Scalar>(
+          polygon, 200, 200, [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+            count += x_end - x_start;
+          } );
+    }
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( outOfBoundsPolygonIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 8 )
+    ->Arg( 100 );
+
+template<typename Scalar>
+static void largePolygonFixedPointIterator( benchmark::State &state )
+{
+  Polygon<Scalar> polygon = createStarPolygon<Scalar>( state.range( 0 ), 200, 200 );
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iteratePolygonSpansFixedPoint<Scalar>(
+        polygon, [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+          count += x_end - x_start;
+        } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( largePolygonFixedPointIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 100 )
+    ->Arg( 500 )
+    ->Arg( 2000 );
+
+//! Counts the cells of 100 rotated rectangles with a size of 120x40 cells.
+//! The argument selects floating-point (0) or fixed-point (1) edge stepping.
+template<typename Scalar>
+static void rectangleSpanIteratorStepping( benchmark::State &state )
+{
+  std::vector<std::array<Vector2<Scalar>, 3>> rectangles;
+  for ( int i = 0; i < 100; ++i ) {
+    const Scalar angle = Scalar( 0.031 ) * i;
+    const Vector2<Scalar> a( 100.3, 20.7 );
+    const Vector2<Scalar> u( std::cos( angle ), std::sin( angle ) ), v( -u.y(), u.x() );
+    rectangles.push_back( { a, Vector2<Scalar>( a + 120 * u ), Vector2<Scalar>( a + 40 * v ) } );
+  }
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    const auto functor = [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+      count += x_end - x_start;
+    };
+    for ( const auto &[a, b, c] : rectangles ) {
+      if ( state.range( 0 ) == 0 )
+        iterateRectangleSpans<Scalar>( a, b, c, functor );
+      else
+        iterateRectangleSpansFixedPoint<Scalar>( a, b, c, functor );
+    }
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( rectangleSpanIteratorStepping, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 0 )
+    ->Arg( 1 );
+
+template<typename Scalar>
+static void largePolygonAreaSum( benchmark::State &state )
+{
+  // Baseline for largePolygonOutlineSum: the outline cells were found by iterating the full area
+  const Polygon<Scalar> polygon =
+      createStarPolygon<Scalar>( 100, state.range( 0 ), state.range( 0 ) );
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 2 * state.range( 0 ), 2 * state.range( 0 ) );
+
+  for ( auto _ : state ) {
+    Scalar sum = 0;
+    iteratePolygon<Scalar>( polygon, map.rows(), map.cols(),
+                            [&]( Eigen::Index x, Eigen::Index y ) { sum += map( x, y ); } );
+    benchmark::DoNotOptimize( sum );
+  }
+}
+BENCHMARK_TEMPLATE( largePolygonAreaSum, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 50 )
+    ->Arg( 200 )
+    ->Arg( 1000 );
+
+template<typename Scalar>
+static void largePolygonRangeSum( benchmark::State &state )
+{
+  // Same as largePolygonAreaSum but using a range-based for loop over a CellRange
+  const Polygon<Scalar> polygon =
+      createStarPolygon<Scalar>( 100, state.range( 0 ), state.range( 0 ) );
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 2 * state.range( 0 ), 2 * state.range( 0 ) );
+
+  for ( auto _ : state ) {
+    Scalar sum = 0;
+    for ( const auto &cell : polygonRange<Scalar>( polygon, map.rows(), map.cols() ) )
+      sum += map( cell.x(), cell.y() );
+    benchmark::DoNotOptimize( sum );
+  }
+}
+BENCHMARK_TEMPLATE( largePolygonRangeSum, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 50 )
+    ->Arg( 200 )
+    ->Arg( 1000 );
+
+template<typename Scalar>
+static void largePolygonOutlineSum( benchmark::State &state )
+{
+  const Polygon<Scalar> polygon =
+      createStarPolygon<Scalar>( 100, state.range( 0 ), state.range( 0 ) );
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 2 * state.range( 0 ), 2 * state.range( 0 ) );
+
+  for ( auto _ : state ) {
+    Scalar sum = 0;
+    iteratePolygonOutline<Scalar>( polygon, map.rows(), map.cols(),
+                                   [&]( Eigen::Index x, Eigen::Index y ) { sum += map( x, y ); } );
+    benchmark::DoNotOptimize( sum );
+  }
+}
+BENCHMARK_TEMPLATE( largePolygonOutlineSum, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 50 )
+    ->Arg( 200 )
+    ->Arg( 1000 );
+
+template<typename Scalar>
+static void polygonCoverageIterator( benchmark::State &state )
+{
+  Polygon<Scalar> polygon = createPolygon<Scalar>();
+  GridMap<Scalar> map = GridMap<Scalar>::Zero( 20, 20 );
+
+  for ( auto _ : state ) {
+    iteratePolygonCoverage<Scalar>( polygon / Scalar( 0.05 ),
+                                    [&map]( Eigen::Index x, Eigen::Index y, Scalar coverage ) {
+                                      map( x, y ) += coverage;
+                                    } );
+  }
+}
+BENCHMARK_TEMPLATE( polygonCoverageIterator, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( polygonCoverageIterator, double )->Unit( benchmark::kMicrosecond );
+
+template<typename Scalar>
+static void largePolygonCoverageSum( benchmark::State &state )
+{
+  // Same polygon as largePolygonAreaSum, the interior runs are passed to the span functor
+  const Polygon<Scalar> polygon =
+      createStarPolygon<Scalar>( 100, state.range( 0 ), state.range( 0 ) );
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 2 * state.range( 0 ), 2 * state.range( 0 ) );
+
+  for ( auto _ : state ) {
+    Scalar sum = 0;
+    iteratePolygonCoverage<Scalar>(
+        polygon, map.rows(), map.cols(),
+        [&]( Eigen::Index x, Eigen::Index y, Scalar coverage ) { sum += coverage * map( x, y ); },
+        [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+          sum += map.col( y ).segment( x_start, x_end - x_start ).sum();
+        } );
+    benchmark::DoNotOptimize( sum );
+  }
+}
+BENCHMARK_TEMPLATE( largePolygonCoverageSum, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 50 )
+    ->Arg( 200 )
+    ->Arg( 1000 );
+
+template<typename Scalar>
+static void multiPolygonIterator( benchmark::State &state )
+{
+  // Star with a star shaped hole, both rings are rasterized in a single pass
+  const Polygon<Scalar> outer = createStarPolygon<Scalar>( state.range( 0 ), 400, 400 );
+  const Polygon<Scalar> inner = createStarPolygon<Scalar>( state.range( 0 ), 200, 400 );
+  const PolygonList<Scalar> rings = { outer, inner };
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 800, 800 );
+
+  for ( auto _ : state ) {
+    Scalar sum = 0;
+    iterateMultiPolygon<Scalar>( rings, FillRule::EvenOdd, map.rows(), map.cols(),
+                                 [&]( Eigen::Index x, Eigen::Index y ) { sum += map( x, y ); } );
+    benchmark::DoNotOptimize( sum );
+  }
+}
+BENCHMARK_TEMPLATE( multiPolygonIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 100 )
+    ->Arg( 500 )
+    ->Arg( 2000 );
+
+template<typename Scalar>
+static Pose2DList<Scalar> createMotionPrimitive( Scalar resolution )
+{
+  // Arc of 20 poses with 7.5cm between consecutive poses, hence, the footprint overlaps heavily
+  Pose2DList<Scalar> poses;
+  for ( int i = 0; i < 20; ++i ) {
+    const Scalar angle = Scalar( 0.05 ) * i;
+    poses.emplace_back( ( 2 + Scalar( 1.5 ) * std::sin( angle ) ) / resolution,
+                        ( 3 - Scalar( 1.5 ) * std::cos( angle ) ) / resolution, angle );
+  }
+  return poses;
+}
+
+template<typename Scalar>
+static void perPoseFootprintIterator( benchmark::State &state )
+{
+  const Scalar resolution = Scalar( state.range( 0 ) ) / 1000;
+  const Polygon<Scalar> footprint = createPolygon<Scalar>() / resolution;
+  const Pose2DList<Scalar> poses = createMotionPrimitive<Scalar>( resolution );
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 5 / resolution, 5 / resolution );
+
+  for ( auto _ : state ) {
+    Scalar sum = 0;
+    Polygon<Scalar> transformed( 2, footprint.cols() );
+    for ( const auto &pose : poses ) {
+      transformed.matrix().noalias() = pose.rotation().toRotationMatrix() * footprint.matrix();
+      transformed.colwise() += pose.translation().array();
+      iteratePolygon<Scalar>( transformed, map.rows(), map.cols(),
+                              [&]( Eigen::Index x, Eigen::Index y ) { sum += map( x, y ); } );
+    }
+    benchmark::DoNotOptimize( sum );
+  }
+}
+BENCHMARK_TEMPLATE( perPoseFootprintIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 50 )
+    ->Arg( 20 )
+    ->Arg( 10 );
+
+template<typename Scalar>
+static void sweptFootprintIterator( benchmark::State &state )
+{
+  const Scalar resolution = Scalar( state.range( 0 ) ) / 1000;
+  const Polygon<Scalar> footprint = createPolygon<Scalar>() / resolution;
+  const Pose2DList<Scalar> poses = createMotionPrimitive<Scalar>( resolution );
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 5 / resolution, 5 / resolution );
+
+  for ( auto _ : state ) {
+    Scalar sum = 0;
+    iterateSweptPolygon<Scalar>( footprint, poses, map.rows(), map.cols(),
+                                 [&]( Eigen::Index x, Eigen::Index y ) { sum += map( x, y ); } );
+    benchmark::DoNotOptimize( sum );
+  }
+}
+BENCHMARK_TEMPLATE( sweptFootprintIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 50 )
+    ->Arg( 20 )
+    ->Arg( 10 );
+
+template<typename Scalar>
+static void parallelPolygonIterator( benchmark::State &state )
+{
+  Polygon<Scalar> polygon = createStarPolygon<Scalar>( 500, 2000, 2000 );
+  ThreadPool pool( state.range( 0 ) );
+  GridMap<Scalar> map = GridMap<Scalar>::Random( 4000, 4000 );
+
+  struct Sum {
+    const GridMap<Scalar> *map;
+    Scalar sum = 0;
+    void operator()( Eigen::Index x, Eigen::Index y ) { sum += ( *map )( x, y ); }
+  };
+  for ( auto _ : state ) {
+    Sum result = iteratePolygonParallel<Scalar>(
+        pool, polygon, map.rows(), map.cols(), Sum{ &map },
+        []( Sum &result, const Sum &band ) { result.sum += band.sum; } );
+    benchmark::DoNotOptimize( result.sum );
+  }
+}
+BENCHMARK_TEMPLATE( parallelPolygonIterator, float )
+    ->Unit( benchmark::kMillisecond )
+    ->UseRealTime()
+    ->Arg( 1 )
+    ->Arg( 2 )
+    ->Arg( 4 );
+
 #if BENCHMARK_ENABLE_GRIDMAP
 static void comparisonGridmapPolygonIterator( benchmark::State &state )
 {
@@ -81,6 +510,184 @@ static void circleIterator( benchmark::State &state )
 BENCHMARK_TEMPLATE( circleIterator, float )->Unit( benchmark::kMicrosecond );
 BENCHMARK_TEMPLATE( circleIterator, double )->Unit( benchmark::kMicrosecond );
 
+template<typename Scalar>
+static void circleSpanIterator( benchmark::State &state )
+{
+  GridMap<Scalar> map( 20, 20 );
+
+  for ( auto _ : state ) {
+    iterateCircleSpans<Scalar>( Vector2<Scalar>( 10, 10 ), 10,
+                                [&map]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                                  map.col( y ).segment( x_start, x_end - x_start ) += 1;
+                                } );
+  }
+}
+BENCHMARK_TEMPLATE( circleSpanIterator, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( circleSpanIterator, double )->Unit( benchmark::kMicrosecond );
+
+template<typename Scalar>
+static std::vector<Vector2<Scalar>> randomCellCenters( int count, int size )
+{
+  std::vector<Vector2<Scalar>> centers;
+  std::mt19937 gen( 42 );
+  std::uniform_int_distribution<int> index_dist( 0, size - 1 );
+  for ( int i = 0; i < count; ++i )
+    centers.emplace_back( index_dist( gen ) + Scalar( 0.5 ), index_dist( gen ) + Scalar( 0.5 ) );
+  return centers;
+}
+
+template<typename Scalar>
+static void circleRepeatedQueries( benchmark::State &state )
+{
+  // Many queries with the same radius at cell centers, e.g., checking an inflation radius
+  const double radius = state.range( 0 );
+  const std::vector<Vector2<Scalar>> centers = randomCellCenters<Scalar>( 1000, 200 );
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    for ( const auto &center : centers ) {
+      iterateCircleSpans<Scalar>( center, radius, 200, 200,
+                                  [&count]( Eigen::Index, Eigen::Index x_start,
+                                            Eigen::Index x_end ) { count += x_end - x_start; } );
+    }
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( circleRepeatedQueries, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 3 )
+    ->Arg( 10 )
+    ->Arg( 40 );
+
+template<typename Scalar>
+static void circleStencilRepeatedQueries( benchmark::State &state )
+{
+  const double radius = state.range( 0 );
+  const std::vector<Vector2<Scalar>> centers = randomCellCenters<Scalar>( 1000, 200 );
+  CircleStencilCache cache;
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    const CircleStencil &stencil = cache.stencil( radius );
+    for ( const auto &center : centers ) {
+      iterateCircleSpans<Scalar>( stencil, center, 200, 200,
+                                  [&count]( Eigen::Index, Eigen::Index x_start,
+                                            Eigen::Index x_end ) { count += x_end - x_start; } );
+    }
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( circleStencilRepeatedQueries, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 3 )
+    ->Arg( 10 )
+    ->Arg( 40 );
+
+template<typename Scalar>
+static void ellipseIterator( benchmark::State &state )
+{
+  const Vector2<Scalar> center( 100, 100 );
+  const double radius_x = state.range( 0 ), radius_y = state.range( 0 ) / 3.0, angle = 0.6;
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iterateEllipseSpans<Scalar>( center, radius_x, radius_y, angle,
+                                 [&count]( Eigen::Index, Eigen::Index x_start,
+                                           Eigen::Index x_end ) { count += x_end - x_start; } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( ellipseIterator, float )->Unit( benchmark::kMicrosecond )->Arg( 10 )->Arg( 90 );
+
+template<typename Scalar>
+static void ellipsePolygonIterator( benchmark::State &state )
+{
+  // Baseline for ellipseIterator: the ellipse approximated by a polygon with 64 vertices
+  const Vector2<Scalar> center( 100, 100 );
+  const double radius_x = state.range( 0 ), radius_y = state.range( 0 ) / 3.0, angle = 0.6;
+
+  Polygon<Scalar> polygon( 2, 64 );
+  for ( int i = 0; i < 64; ++i ) {
+    const double t = 2 * M_PI * i / 64;
+    const double u = radius_x * std::cos( t ), v = radius_y * std::sin( t );
+    polygon.col( i ) << center.x() + u * std::cos( angle ) - v * std::sin( angle ),
+        center.y() + u * std::sin( angle ) + v * std::cos( angle );
+  }
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iteratePolygonSpans<Scalar>(
+        polygon, [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+          count += x_end - x_start;
+        } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( ellipsePolygonIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 10 )
+    ->Arg( 90 );
+
+template<typename Scalar>
+static void sectorIterator( benchmark::State &state )
+{
+  const Vector2<Scalar> center( 100, 100 );
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iterateSectorSpans<Scalar>( center, state.range( 0 ), 0.4, 2.0,
+                                [&count]( Eigen::Index, Eigen::Index x_start,
+                                          Eigen::Index x_end ) { count += x_end - x_start; } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( sectorIterator, float )->Unit( benchmark::kMicrosecond )->Arg( 10 )->Arg( 90 );
+
+template<typename Scalar>
+static void sectorPolygonIterator( benchmark::State &state )
+{
+  // Baseline for sectorIterator: the sector approximated by a polygon with the apex and 63 vertices
+  // on the arc
+  const Vector2<Scalar> center( 100, 100 );
+  const double radius = state.range( 0 );
+
+  Polygon<Scalar> polygon( 2, 64 );
+  polygon.col( 0 ) = center;
+  for ( int i = 1; i < 64; ++i ) {
+    const double angle = 0.4 - 1.0 + 2.0 * ( i - 1 ) / 62;
+    polygon.col( i ) << center.x() + radius * std::cos( angle ),
+        center.y() + radius * std::sin( angle );
+  }
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iteratePolygonSpans<Scalar>(
+        polygon, [&count]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+          count += x_end - x_start;
+        } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( sectorPolygonIterator, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 10 )
+    ->Arg( 90 );
+
+template<typename Scalar>
+static void annulusIterator( benchmark::State &state )
+{
+  const Vector2<Scalar> center( 100, 100 );
+
+  for ( auto _ : state ) {
+    Eigen::Index count = 0;
+    iterateAnnulusSpans<Scalar>( center, state.range( 0 ) / 2.0, state.range( 0 ),
+                                 [&count]( Eigen::Index, Eigen::Index x_start,
+                                           Eigen::Index x_end ) { count += x_end - x_start; } );
+    benchmark::DoNotOptimize( count );
+  }
+}
+BENCHMARK_TEMPLATE( annulusIterator, float )->Unit( benchmark::kMicrosecond )->Arg( 10 )->Arg( 90 );
+
 #if BENCHMARK_ENABLE_GRIDMAP
 static void comparisonGridmapCircleIterator( benchmark::State &state )
 {
@@ -100,4 +707,86 @@ static void comparisonGridmapCircleIterator( benchmark::State &state )
 BENCHMARK( comparisonGridmapCircleIterator )->Unit( benchmark::kMicrosecond );
 #endif
 
+template<typename Scalar>
+static void lineIterator( benchmark::State &state )
+{
+  GridMap<Scalar> map = GridMap<Scalar>::Zero( 200, 200 );
+  const Vector2<Scalar> origin( 100.3, 100.6 );
+
+  // 360 beams with a length of 90 cells
+  for ( auto _ : state ) {
+    for ( int i = 0; i < 360; ++i ) {
+      const Scalar angle = i * M_PI / 180;
+      const Vector2<Scalar> end =
+          origin + Scalar( 90 ) * Vector2<Scalar>( std::cos( angle ), std::sin( angle ) );
+      iterateLine<Scalar>( origin, end, map.rows(), map.cols(),
+                           [&map]( Eigen::Index x, Eigen::Index y ) { ++map( x, y ); } );
+    }
+  }
+}
+BENCHMARK_TEMPLATE( lineIterator, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( lineIterator, double )->Unit( benchmark::kMicrosecond );
+
+template<typename Scalar>
+static void lineIteratorLongBeams( benchmark::State &state )
+{
+  GridMap<Scalar> map = GridMap<Scalar>::Zero( 200, 200 );
+  const Vector2<Scalar> center( 100.3, 100.6 );
+
+  // 360 beams with a length of 20000 cells crossing the map, only the part in the map is iterated
+  for ( auto _ : state ) {
+    for ( int i = 0; i < 360; ++i ) {
+      const Scalar angle = i * M_PI / 180;
+      const Vector2<Scalar> direction( std::cos( angle ), std::sin( angle ) );
+      iterateLine<Scalar>( center - Scalar( 10000 ) * direction,
+                           center + Scalar( 10000 ) * direction, map.rows(), map.cols(),
+                           [&map]( Eigen::Index x, Eigen::Index y ) { ++map( x, y ); } );
+    }
+  }
+}
+BENCHMARK_TEMPLATE( lineIteratorLongBeams, float )->Unit( benchmark::kMicrosecond );
+
+template<typename Scalar>
+static void lineSupercoverIterator( benchmark::State &state )
+{
+  GridMap<Scalar> map = GridMap<Scalar>::Zero( 200, 200 );
+  const Vector2<Scalar> origin( 100.3, 100.6 );
+
+  for ( auto _ : state ) {
+    for ( int i = 0; i < 360; ++i ) {
+      const Scalar angle = i * M_PI / 180;
+      const Vector2<Scalar> end =
+          origin + Scalar( 90 ) * Vector2<Scalar>( std::cos( angle ), std::sin( angle ) );
+      iterateLineSupercover<Scalar>( origin, end, map.rows(), map.cols(),
+                                     [&map]( Eigen::Index x, Eigen::Index y ) { ++map( x, y ); } );
+    }
+  }
+}
+BENCHMARK_TEMPLATE( lineSupercoverIterator, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( lineSupercoverIterator, double )->Unit( benchmark::kMicrosecond );
+
+#if BENCHMARK_ENABLE_GRIDMAP
+static void comparisonGridmapLineIterator( benchmark::State &state )
+{
+  grid_map::GridMap map( { "type" } );
+  map.setGeometry( grid_map::Length( 200, 200 ), 1 );
+  GridMap<float> data = GridMap<float>::Zero( 200, 200 );
+  const grid_map::Position origin( 0.3, 0.6 );
+
+  // For fairness we also just use the iterator to access a 2D array to rule out grid map access performance impacting the benchmark
+  for ( auto _ : state ) {
+    for ( int i = 0; i < 360; ++i ) {
+      const double angle = i * M_PI / 180;
+      const grid_map::Position end =
+          origin + 90 * grid_map::Position( std::cos( angle ), std::sin( angle ) );
+      for ( grid_map::LineIterator iterator( map, origin, end ); !iterator.isPastEnd(); ++iterator ) {
+        ++data( ( *iterator ).x(), ( *iterator ).y() );
+      }
+    }
+  }
+}
+
+BENCHMARK( comparisonGridmapLineIterator )->Unit( benchmark::kMicrosecond );
+#endif
+
 BENCHMARK_MAIN();
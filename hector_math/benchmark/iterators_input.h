@@ -5,6 +5,7 @@
 #define HECTOR_MATH_ITERATORS_INPUT_H
 
 #include "hector_math/types.h"
+#include <random>
 
 template<typename Scalar>
 hector_math::Polygon<Scalar> createPolygon()
@@ -35,4 +36,20 @@ hector_math::Polygon<Scalar> createSkewedQuadranglePolygon()
   return result;
 }
 
+//! Creates a star-shaped polygon with the given number of vertices and random radii between
+//! 0.5 * radius and radius around the given center.
+template<typename Scalar>
+hector_math::Polygon<Scalar> createStarPolygon( int vertices, Scalar radius, Scalar center )
+{
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> dist( 0.5 * radius, radius );
+  hector_math::Polygon<Scalar> result( 2, vertices );
+  for ( int i = 0; i < vertices; ++i ) {
+    const Scalar angle = 2 * M_PI * i / vertices;
+    const Scalar r = dist( gen );
+    result.col( i ) << center + r * std::cos( angle ), center + r * std::sin( angle );
+  }
+  return result;
+}
+
 #endif // HECTOR_MATH_ITERATORS_INPUT_H
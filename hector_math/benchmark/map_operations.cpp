@@ -0,0 +1,453 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "hector_math/map_operations/find_minmax.h"
+#include "hector_math/map_operations/find_minmax_parallel.h"
+#include "hector_math/map_operations/find_minmax_tiled.h"
+#include "hector_math/map_operations/find_statistics.h"
+#include "hector_math/map_operations/integral_image.h"
+#include "hector_math/map_operations/range_extremum_table.h"
+#include "hector_math/map_operations/raycast.h"
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace hector_math;
+
+//! Casts a LiDAR-like scan of 5760 beams with a range of 15m over a 1000x1000 height map with a
+//! resolution of 0.05m. The argument is the number of threads, 0 means no thread pool is used.
+template<typename Scalar>
+static void raycastHeightMapScan( benchmark::State &state )
+{
+  const Scalar resolution = 0.05;
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> height_dist( 0, 0.3 );
+  GridMap<Scalar> map( 1000, 1000 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x ) map( x, y ) = height_dist( gen );
+  }
+  const Vector3<Scalar> origin( 25.02, 24.97, 1.2 );
+  Vector3List<Scalar> ends;
+  for ( int layer = 0; layer < 16; ++layer ) {
+    const Scalar z = origin.z() - Scalar( 0.5 ) - Scalar( 0.15 ) * layer;
+    for ( int i = 0; i < 360; ++i ) {
+      const Scalar angle = i * M_PI / 180;
+      ends.emplace_back( origin.x() + 15 * std::cos( angle ),
+                         origin.y() + 15 * std::sin( angle ), z );
+    }
+  }
+  std::unique_ptr<ThreadPool> pool;
+  if ( state.range( 0 ) > 0 )
+    pool = std::make_unique<ThreadPool>( state.range( 0 ) );
+
+  for ( auto _ : state ) {
+    auto results = raycastHeightMap( map, resolution, origin, ends, pool.get() );
+    benchmark::DoNotOptimize( results.data() );
+  }
+}
+BENCHMARK_TEMPLATE( raycastHeightMapScan, float )
+    ->Unit( benchmark::kMillisecond )
+    ->UseRealTime()
+    ->Arg( 0 )
+    ->Arg( 1 )
+    ->Arg( 2 )
+    ->Arg( 4 );
+BENCHMARK_TEMPLATE( raycastHeightMapScan, double )
+    ->Unit( benchmark::kMillisecond )
+    ->UseRealTime()
+    ->Arg( 0 )
+    ->Arg( 4 );
+
+//! Large height map with the size given in cells per side. The maps are created once and shared
+//! between the benchmarks since a 16k x 16k float map takes 1 GB.
+template<typename Scalar>
+const GridMap<Scalar> &largeMap( Eigen::Index size )
+{
+  static std::map<Eigen::Index, GridMap<Scalar>> maps;
+  auto it = maps.find( size );
+  if ( it != maps.end() )
+    return it->second;
+  GridMap<Scalar> &map = maps[size];
+  map.resize( size, size );
+  for ( Eigen::Index y = 0; y < size; ++y ) {
+    for ( Eigen::Index x = 0; x < size; ++x )
+      map( x, y ) = std::sin( Scalar( 0.01 ) * x ) * std::cos( Scalar( 0.013 ) * y );
+  }
+  return map;
+}
+
+template<typename Scalar>
+const TiledGridMap<Scalar> &largeTiledMap( Eigen::Index size )
+{
+  static std::map<Eigen::Index, TiledGridMap<Scalar>> maps;
+  auto it = maps.find( size );
+  if ( it != maps.end() )
+    return it->second;
+  return maps.emplace( size, TiledGridMap<Scalar>( largeMap<Scalar>( size ) ) ).first->second;
+}
+
+//! 1000 region queries, e.g., footprints or local planning windows, with a side length of 256
+//! cells, a random orientation and a random location in the map with the given size.
+template<typename Scalar>
+std::vector<Polygon<Scalar>> randomRegions( Eigen::Index size )
+{
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> position_dist( 256, size - 256 );
+  std::uniform_real_distribution<Scalar> angle_dist( 0, M_PI );
+  Polygon<Scalar> square( 2, 4 );
+  square << -128, 128, 128, -128, //
+      -128, -128, 128, 128;
+  std::vector<Polygon<Scalar>> regions;
+  for ( int i = 0; i < 1000; ++i ) {
+    const Eigen::Rotation2D<Scalar> rotation( angle_dist( gen ) );
+    Polygon<Scalar> region = ( rotation.toRotationMatrix() * square.matrix() ).array();
+    region.colwise() += Point<Scalar>( position_dist( gen ), position_dist( gen ) );
+    regions.push_back( region );
+  }
+  return regions;
+}
+
+//! Minimum of random regions of a GridMap. The argument is the map size.
+template<typename Scalar>
+static void regionMinimumGridMap( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = largeMap<Scalar>( state.range( 0 ) );
+  const std::vector<Polygon<Scalar>> regions = randomRegions<Scalar>( state.range( 0 ) );
+  for ( auto _ : state ) {
+    for ( const auto &region : regions )
+      benchmark::DoNotOptimize( findMinimum<Scalar>( map, region ) );
+  }
+}
+BENCHMARK_TEMPLATE( regionMinimumGridMap, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Arg( 4096 )
+    ->Arg( 16384 );
+
+//! Minimum, maximum, mean and variance of random regions computed with separate passes.
+template<typename Scalar>
+static void regionStatisticsSeparatePasses( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = largeMap<Scalar>( state.range( 0 ) );
+  const std::vector<Polygon<Scalar>> regions = randomRegions<Scalar>( state.range( 0 ) );
+  for ( auto _ : state ) {
+    for ( const auto &region : regions ) {
+      benchmark::DoNotOptimize( findMinimum<Scalar>( map, region ) );
+      benchmark::DoNotOptimize( findMaximum<Scalar>( map, region ) );
+      Scalar sum = 0, sum_squares = 0;
+      Eigen::Index count = 0;
+      iteratePolygon( region, map.rows(), map.cols(), [&]( Eigen::Index x, Eigen::Index y ) {
+        const Scalar val = map( x, y );
+        if ( std::isnan( val ) )
+          return;
+        sum += val;
+        sum_squares += val * val;
+        ++count;
+      } );
+      benchmark::DoNotOptimize( sum / count );
+      benchmark::DoNotOptimize( sum_squares / count - sum * sum / ( count * count ) );
+    }
+  }
+}
+BENCHMARK_TEMPLATE( regionStatisticsSeparatePasses, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Arg( 4096 )
+    ->Arg( 16384 );
+
+//! The same statistics of random regions computed in a single pass with findStatistics.
+template<typename Scalar>
+static void regionStatistics( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = largeMap<Scalar>( state.range( 0 ) );
+  const std::vector<Polygon<Scalar>> regions = randomRegions<Scalar>( state.range( 0 ) );
+  for ( auto _ : state ) {
+    for ( const auto &region : regions ) {
+      RegionStatistics<Scalar> stats = findStatistics<Scalar>( map, region );
+      benchmark::DoNotOptimize( stats );
+    }
+  }
+}
+BENCHMARK_TEMPLATE( regionStatistics, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Arg( 4096 )
+    ->Arg( 16384 );
+
+//! Minimum of random regions of a TiledGridMap with 64x64 tiles.
+template<typename Scalar>
+static void regionMinimumTiledGridMap( benchmark::State &state )
+{
+  const TiledGridMap<Scalar> &map = largeTiledMap<Scalar>( state.range( 0 ) );
+  const std::vector<Polygon<Scalar>> regions = randomRegions<Scalar>( state.range( 0 ) );
+  for ( auto _ : state ) {
+    for ( const auto &region : regions )
+      benchmark::DoNotOptimize( findMinimum( map, region ) );
+  }
+}
+BENCHMARK_TEMPLATE( regionMinimumTiledGridMap, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Arg( 4096 )
+    ->Arg( 16384 );
+
+//! Sum of random regions of a GridMap which is limited by the memory bandwidth.
+template<typename Scalar>
+static void regionSumGridMap( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = largeMap<Scalar>( state.range( 0 ) );
+  const std::vector<Polygon<Scalar>> regions = randomRegions<Scalar>( state.range( 0 ) );
+  for ( auto _ : state ) {
+    for ( const auto &region : regions ) {
+      Scalar sum = 0;
+      iteratePolygonSpans( region, map.rows(), map.cols(),
+                           [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                             sum += map.col( y ).segment( x_start, x_end - x_start ).sum();
+                           } );
+      benchmark::DoNotOptimize( sum );
+    }
+  }
+}
+BENCHMARK_TEMPLATE( regionSumGridMap, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Arg( 4096 )
+    ->Arg( 16384 );
+
+//! Sum of random regions of a TiledGridMap iterated tile by tile.
+template<typename Scalar>
+static void regionSumTiledGridMap( benchmark::State &state )
+{
+  using Vector = Eigen::Array<Scalar, Eigen::Dynamic, 1>;
+  const TiledGridMap<Scalar> &map = largeTiledMap<Scalar>( state.range( 0 ) );
+  const std::vector<Polygon<Scalar>> regions = randomRegions<Scalar>( state.range( 0 ) );
+  for ( auto _ : state ) {
+    for ( const auto &region : regions ) {
+      Scalar sum = 0;
+      iterateTiledSpans(
+          [&]( auto &&f ) { return iteratePolygonSpans( region, map.rows(), map.cols(), f ); },
+          [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+            sum += Eigen::Map<const Vector>( map.data( x_start, y ), x_end - x_start ).sum();
+          } );
+      benchmark::DoNotOptimize( sum );
+    }
+  }
+}
+BENCHMARK_TEMPLATE( regionSumTiledGridMap, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Arg( 4096 )
+    ->Arg( 16384 );
+
+//! Map with random values and 1% NaN values.
+template<typename Scalar>
+const GridMap<Scalar> &randomMapWithNaNs( Eigen::Index size )
+{
+  static std::map<Eigen::Index, GridMap<Scalar>> maps;
+  auto it = maps.find( size );
+  if ( it != maps.end() )
+    return it->second;
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> value_dist( -100, 100 );
+  std::uniform_int_distribution<int> nan_dist( 0, 99 );
+  GridMap<Scalar> &map = maps[size];
+  map.resize( size, size );
+  for ( Eigen::Index y = 0; y < size; ++y ) {
+    for ( Eigen::Index x = 0; x < size; ++x )
+      map( x, y ) = nan_dist( gen ) == 0 ? std::numeric_limits<Scalar>::quiet_NaN()
+                                         : value_dist( gen );
+  }
+  return map;
+}
+
+template<typename Scalar>
+static void findMinimumAndIndexMap( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = randomMapWithNaNs<Scalar>( state.range( 0 ) );
+
+  for ( auto _ : state ) {
+    Eigen::Index row = 0, col = 0;
+    benchmark::DoNotOptimize( findMinimumAndIndex( map, row, col ) );
+    benchmark::DoNotOptimize( row );
+    benchmark::DoNotOptimize( col );
+  }
+  state.SetBytesProcessed( state.iterations() * map.size() * sizeof( Scalar ) );
+}
+BENCHMARK_TEMPLATE( findMinimumAndIndexMap, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 512 )
+    ->Arg( 2048 )
+    ->Arg( 8192 );
+BENCHMARK_TEMPLATE( findMinimumAndIndexMap, double )->Unit( benchmark::kMicrosecond )->Arg( 2048 );
+
+template<typename Scalar>
+static void findMaximumAndIndexMap( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = randomMapWithNaNs<Scalar>( state.range( 0 ) );
+
+  for ( auto _ : state ) {
+    Eigen::Index row = 0, col = 0;
+    benchmark::DoNotOptimize( findMaximumAndIndex( map, row, col ) );
+    benchmark::DoNotOptimize( row );
+    benchmark::DoNotOptimize( col );
+  }
+  state.SetBytesProcessed( state.iterations() * map.size() * sizeof( Scalar ) );
+}
+BENCHMARK_TEMPLATE( findMaximumAndIndexMap, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 512 )
+    ->Arg( 2048 )
+    ->Arg( 8192 );
+
+template<typename Scalar>
+static void findMinimumAndIndexMapParallel( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = randomMapWithNaNs<Scalar>( state.range( 0 ) );
+  ThreadPool pool( state.range( 1 ) );
+
+  for ( auto _ : state ) {
+    Eigen::Index row = 0, col = 0;
+    benchmark::DoNotOptimize( findMinimumAndIndexParallel( pool, map, row, col ) );
+    benchmark::DoNotOptimize( row );
+    benchmark::DoNotOptimize( col );
+  }
+  state.SetBytesProcessed( state.iterations() * map.size() * sizeof( Scalar ) );
+}
+BENCHMARK_TEMPLATE( findMinimumAndIndexMapParallel, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->UseRealTime()
+    ->Args( { 2048, 1 } )
+    ->Args( { 2048, 2 } )
+    ->Args( { 2048, 4 } )
+    ->Args( { 8192, 1 } )
+    ->Args( { 8192, 4 } )
+    ->Args( { 8192, 16 } );
+
+//! Mean of a sliding window around every cell of a map, e.g., for roughness features.
+//! The arguments are the map size and the window size.
+template<typename Scalar>
+static void slidingWindowMean( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = randomMapWithNaNs<Scalar>( state.range( 0 ) );
+  const Eigen::Index window = state.range( 1 );
+  GridMap<Scalar> result( map.rows(), map.cols() );
+  for ( auto _ : state ) {
+    for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+      for ( Eigen::Index x = 0; x < map.rows(); ++x ) {
+        Scalar sum = 0;
+        Eigen::Index count = 0;
+        const Eigen::Index x_start = std::max<Eigen::Index>( 0, x - window / 2 );
+        const Eigen::Index y_start = std::max<Eigen::Index>( 0, y - window / 2 );
+        const Eigen::Index x_end = std::min( map.rows(), x - window / 2 + window );
+        const Eigen::Index y_end = std::min( map.cols(), y - window / 2 + window );
+        for ( Eigen::Index j = y_start; j < y_end; ++j ) {
+          for ( Eigen::Index i = x_start; i < x_end; ++i ) {
+            if ( std::isnan( map( i, j ) ) )
+              continue;
+            sum += map( i, j );
+            ++count;
+          }
+        }
+        result( x, y ) = count == 0 ? std::numeric_limits<Scalar>::quiet_NaN() : sum / count;
+      }
+    }
+    benchmark::DoNotOptimize( result.data() );
+  }
+}
+BENCHMARK_TEMPLATE( slidingWindowMean, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Args( { 512, 5 } )
+    ->Args( { 512, 15 } )
+    ->Args( { 2048, 15 } );
+
+//! The same sliding window mean using an IntegralImage, including building the table.
+template<typename Scalar>
+static void slidingWindowMeanIntegralImage( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = randomMapWithNaNs<Scalar>( state.range( 0 ) );
+  const Eigen::Index window = state.range( 1 );
+  GridMap<Scalar> result( map.rows(), map.cols() );
+  IntegralImage<Scalar> image;
+  for ( auto _ : state ) {
+    image.compute( map );
+    for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+      for ( Eigen::Index x = 0; x < map.rows(); ++x )
+        result( x, y ) = image.mean( x - window / 2, y - window / 2, window, window );
+    }
+    benchmark::DoNotOptimize( result.data() );
+  }
+}
+BENCHMARK_TEMPLATE( slidingWindowMeanIntegralImage, float )
+    ->Unit( benchmark::kMillisecond )
+    ->Args( { 512, 5 } )
+    ->Args( { 512, 15 } )
+    ->Args( { 2048, 15 } );
+
+//! 1000 axis-aligned footprints with the given side length at random locations in a 2048 map.
+static std::vector<Eigen::Vector2i> randomFootprintCorners( Eigen::Index size )
+{
+  std::mt19937 gen( 42 );
+  std::uniform_int_distribution<int> position_dist( 0, 2048 - size );
+  std::vector<Eigen::Vector2i> corners;
+  for ( int i = 0; i < 1000; ++i ) corners.emplace_back( position_dist( gen ), position_dist( gen ) );
+  return corners;
+}
+
+//! Minimum of axis-aligned footprints using findMinimum. The argument is the side length.
+template<typename Scalar>
+static void footprintMinimum( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = largeMap<Scalar>( 2048 );
+  const Scalar size = state.range( 0 );
+  std::vector<Polygon<Scalar>> footprints;
+  for ( const auto &corner : randomFootprintCorners( state.range( 0 ) ) ) {
+    Polygon<Scalar> footprint( 2, 4 );
+    footprint << 0, size, size, 0, //
+        0, 0, size, size;
+    footprint.colwise() += corner.cast<Scalar>().array();
+    footprints.push_back( footprint );
+  }
+  for ( auto _ : state ) {
+    for ( const auto &footprint : footprints )
+      benchmark::DoNotOptimize( findMinimum<Scalar>( map, footprint ) );
+  }
+}
+BENCHMARK_TEMPLATE( footprintMinimum, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 8 )
+    ->Arg( 20 )
+    ->Arg( 64 )
+    ->Arg( 200 );
+
+//! Minimum of the same footprints using a RangeMinimumTable.
+template<typename Scalar>
+static void footprintMinimumRangeTable( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = largeMap<Scalar>( 2048 );
+  const Eigen::Index size = state.range( 0 );
+  const std::vector<Eigen::Vector2i> corners = randomFootprintCorners( size );
+  const RangeMinimumTable<Scalar> table( map );
+  for ( auto _ : state ) {
+    for ( const auto &corner : corners )
+      benchmark::DoNotOptimize( table.query( corner.x(), corner.y(), size, size ) );
+  }
+}
+BENCHMARK_TEMPLATE( footprintMinimumRangeTable, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 8 )
+    ->Arg( 20 )
+    ->Arg( 64 )
+    ->Arg( 200 );
+
+//! Building a RangeMinimumTable for a 2048 map. The argument is the max level.
+template<typename Scalar>
+static void rangeTableBuild( benchmark::State &state )
+{
+  const GridMap<Scalar> &map = largeMap<Scalar>( 2048 );
+  RangeMinimumTable<Scalar> table;
+  for ( auto _ : state ) {
+    table.compute( map, state.range( 0 ) );
+    benchmark::DoNotOptimize( table );
+  }
+  state.counters["table_size"] = table.size();
+}
+BENCHMARK_TEMPLATE( rangeTableBuild, float )->Unit( benchmark::kMillisecond )->Arg( 3 )->Arg( 5 );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,79 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "hector_math/map_operations/find_minmax.h"
+#include "hector_math/robot/robot_footprint.h"
+#include "iterators_input.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+using namespace hector_math;
+
+template<typename Scalar>
+struct FootprintBenchmarkInput {
+  static constexpr Scalar resolution = 0.02;
+
+  FootprintBenchmarkInput()
+  {
+    footprint = createPolygon<Scalar>();
+    footprint.colwise() -= Point<Scalar>( 0.5, 0.5 );
+    map = GridMap<Scalar>::Random( 500, 500 );
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution<Scalar> position_dist( 1, 9 );
+    std::uniform_real_distribution<Scalar> angle_dist( -M_PI, M_PI );
+    for ( int i = 0; i < 1024; ++i ) {
+      positions.emplace_back( position_dist( gen ), position_dist( gen ) );
+      orientations.push_back( angle_dist( gen ) );
+    }
+  }
+
+  Polygon<Scalar> footprint;
+  GridMap<Scalar> map;
+  Vector2List<Scalar> positions;
+  std::vector<Scalar> orientations;
+};
+
+template<typename Scalar>
+static void footprintMinimumRasterized( benchmark::State &state )
+{
+  FootprintBenchmarkInput<Scalar> input;
+  size_t i = 0;
+  for ( auto _ : state ) {
+    const Eigen::Rotation2D<Scalar> rotation( input.orientations[i] );
+    const Polygon<Scalar> transformed =
+        ( ( rotation.toRotationMatrix() * input.footprint.matrix() ).colwise() + input.positions[i] )
+            .array() /
+        input.resolution;
+    benchmark::DoNotOptimize( findMinimum<Scalar>( input.map, transformed ) );
+    i = ( i + 1 ) % input.positions.size();
+  }
+}
+BENCHMARK_TEMPLATE( footprintMinimumRasterized, float )->Unit( benchmark::kMicrosecond );
+BENCHMARK_TEMPLATE( footprintMinimumRasterized, double )->Unit( benchmark::kMicrosecond );
+
+template<typename Scalar>
+static void footprintMinimumStampCache( benchmark::State &state )
+{
+  FootprintBenchmarkInput<Scalar> input;
+  PolygonRobotFootprint<Scalar> footprint( input.footprint, input.resolution, state.range( 0 ), 4 );
+  size_t i = 0;
+  for ( auto _ : state ) {
+    benchmark::DoNotOptimize( footprint.getMinimum( input.map, input.positions[i],
+                                                    input.orientations[i],
+                                                    std::numeric_limits<Scalar>::lowest() ) );
+    i = ( i + 1 ) % input.positions.size();
+  }
+}
+BENCHMARK_TEMPLATE( footprintMinimumStampCache, float )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 16 )
+    ->Arg( 32 )
+    ->Arg( 64 );
+BENCHMARK_TEMPLATE( footprintMinimumStampCache, double )
+    ->Unit( benchmark::kMicrosecond )
+    ->Arg( 16 )
+    ->Arg( 32 )
+    ->Arg( 64 );
+
+BENCHMARK_MAIN();
@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_TILED_GRID_MAP_H
+#define HECTOR_MATH_TILED_GRID_MAP_H
+
+#include "hector_math/types.h"
+#include <algorithm>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * A 2D grid that stores its cells in square tiles of TileSize x TileSize cells.
+ * Each tile is stored contiguously in column-major order, i.e., x is the inner index as for a
+ * GridMap, and the tiles are stored in column-major order as well.
+ * In contrast to a GridMap, where two cells in neighboring rows y and y + 1 are map.rows() cells
+ * apart, a region of a large map touches only a few contiguous blocks of memory. Hence, region
+ * queries on maps with thousands of cells per side load far fewer cache lines and pages.
+ * Iterate the regions in tile order using iterateTiled or iterateTiledSpans to benefit from this.
+ *
+ * Cells of the tiles at the border that are outside of the map are allocated but not used.
+ * @tparam Scalar The type of the cells.
+ * @tparam TileSize The number of cells per side of a tile. Has to be a power of two.
+ */
+template<typename Scalar, int TileSize = 64>
+class TiledGridMap
+{
+  static_assert( TileSize > 0 && ( TileSize & ( TileSize - 1 ) ) == 0,
+                 "TileSize has to be a power of two!" );
+
+public:
+  static constexpr int Size = TileSize;
+  static constexpr Eigen::Index TileCells = Eigen::Index( TileSize ) * TileSize;
+  using Tile = Eigen::Array<Scalar, TileSize, TileSize>;
+
+  TiledGridMap() = default;
+
+  TiledGridMap( Eigen::Index rows, Eigen::Index cols ) { resize( rows, cols ); }
+
+  //! Creates a tiled copy of the given map.
+  explicit TiledGridMap( const Eigen::Ref<const GridMap<Scalar>> &map )
+  {
+    resize( map.rows(), map.cols() );
+    for ( Eigen::Index y = 0; y < cols_; ++y ) {
+      for ( Eigen::Index x = 0; x < rows_; x += TileSize ) {
+        const Eigen::Index count = std::min<Eigen::Index>( TileSize, rows_ - x );
+        std::copy_n( map.data() + x + y * map.outerStride(), count, data( x, y ) );
+      }
+    }
+  }
+
+  //! Resizes the map to the given size. The values of the cells are uninitialized afterwards.
+  void resize( Eigen::Index rows, Eigen::Index cols )
+  {
+    rows_ = rows;
+    cols_ = cols;
+    tile_rows_ = ( rows + TileSize - 1 ) / TileSize;
+    tile_cols_ = ( cols + TileSize - 1 ) / TileSize;
+    data_.resize( tile_rows_ * tile_cols_ * TileCells );
+  }
+
+  //! Sets all cells, including the unused cells of the border tiles, to the given value.
+  void setConstant( Scalar value ) { std::fill( data_.begin(), data_.end(), value ); }
+
+  //! @returns The number of rows, i.e., the size in x direction.
+  Eigen::Index rows() const { return rows_; }
+  //! @returns The number of columns, i.e., the size in y direction.
+  Eigen::Index cols() const { return cols_; }
+  //! @returns The number of tiles in x direction.
+  Eigen::Index tileRows() const { return tile_rows_; }
+  //! @returns The number of tiles in y direction.
+  Eigen::Index tileCols() const { return tile_cols_; }
+
+  Scalar &operator()( Eigen::Index x, Eigen::Index y ) { return data_[index( x, y )]; }
+
+  const Scalar &operator()( Eigen::Index x, Eigen::Index y ) const { return data_[index( x, y )]; }
+
+  /*!
+   * @returns A pointer to the cell (x, y). The cells (x + i, y) up to the end of the tile, i.e.,
+   *   for x + i < (x / TileSize + 1) * TileSize, directly follow in memory.
+   */
+  Scalar *data( Eigen::Index x, Eigen::Index y ) { return data_.data() + index( x, y ); }
+
+  //! @copydoc data(Eigen::Index, Eigen::Index)
+  const Scalar *data( Eigen::Index x, Eigen::Index y ) const
+  {
+    return data_.data() + index( x, y );
+  }
+
+  //! @returns A view on the tile with the tile indexes (tile_x, tile_y).
+  Eigen::Map<Tile> tile( Eigen::Index tile_x, Eigen::Index tile_y )
+  {
+    return Eigen::Map<Tile>( data_.data() + ( tile_x + tile_y * tile_rows_ ) * TileCells );
+  }
+
+  //! @copydoc tile(Eigen::Index, Eigen::Index)
+  Eigen::Map<const Tile> tile( Eigen::Index tile_x, Eigen::Index tile_y ) const
+  {
+    return Eigen::Map<const Tile>( data_.data() + ( tile_x + tile_y * tile_rows_ ) * TileCells );
+  }
+
+  //! @returns A copy of this map in the column-major layout of a GridMap.
+  GridMap<Scalar> toGridMap() const
+  {
+    GridMap<Scalar> result( rows_, cols_ );
+    for ( Eigen::Index y = 0; y < cols_; ++y ) {
+      for ( Eigen::Index x = 0; x < rows_; x += TileSize ) {
+        const Eigen::Index count = std::min<Eigen::Index>( TileSize, rows_ - x );
+        std::copy_n( data( x, y ), count, &result( x, y ) );
+      }
+    }
+    return result;
+  }
+
+private:
+  Eigen::Index index( Eigen::Index x, Eigen::Index y ) const
+  {
+    const Eigen::Index tile_index = x / TileSize + ( y / TileSize ) * tile_rows_;
+    return tile_index * TileCells + ( x % TileSize ) + ( y % TileSize ) * TileSize;
+  }
+
+  std::vector<Scalar> data_;
+  Eigen::Index rows_ = 0;
+  Eigen::Index cols_ = 0;
+  Eigen::Index tile_rows_ = 0;
+  Eigen::Index tile_cols_ = 0;
+};
+} // namespace hector_math
+
+#endif // HECTOR_MATH_TILED_GRID_MAP_H
@@ -0,0 +1,154 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_ANNULUS_ITERATOR_H
+#define HECTOR_MATH_ANNULUS_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/types.h"
+
+namespace hector_math
+{
+/*!
+ * Iterates over all indexes that lie in the given annulus, i.e., the ring between two concentric circles, and for
+ * each index (x, y) calls the given functor.
+ * This method will iterate all cells that are visited by iterateCircle for the outer radius but not for the inner
+ * radius, i.e., where the center of the cell (x+0.5, y+0.5) is inside the outer but not inside the inner circle.
+ * Note: The annulus has to be in the index space, hence, if it is in map coordinates it might be necessary to divide
+ *   it by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where row/col_min is included
+ * but row/col_max is excluded, i.e., the largest x index functor may be called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param center The center of the annulus that is iterated over.
+ * @param inner_radius The radius of the inner circle whose cells are excluded.
+ * @param outer_radius The radius of the outer circle.
+ * @param functor The function that will be called for each index (x, y) inside the annulus.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateAnnulus( const Vector2<T> &center, double inner_radius, double outer_radius,
+                     Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                     Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateAnnulus where row_min and col_min are set to 0 to allow for bounded iteration
+//! of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateAnnulus( const Vector2<T> &center, double inner_radius, double outer_radius,
+                     Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateAnnulus( center, inner_radius, outer_radius, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateAnnulus where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateAnnulus( const Vector2<T> &center, double inner_radius, double outer_radius,
+                     Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateAnnulus( center, inner_radius, outer_radius, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the given annulus and for each row y calls the given
+ * functor once for each of the up to two runs of indexes [x_start, x_end) that lie in the annulus.
+ * The same cells as in iterateAnnulus are visited. The runs of each row are computed in closed form
+ * and passed in ascending x. Empty runs are not passed to the functor.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param center The center of the annulus that is iterated over.
+ * @param inner_radius The radius of the inner circle whose cells are excluded.
+ * @param outer_radius The radius of the outer circle.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateAnnulusSpans( const Vector2<T> &center, double inner_radius, double outer_radius,
+                          Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                          Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateAnnulusSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateAnnulusSpans( const Vector2<T> &center, double inner_radius, double outer_radius,
+                          Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateAnnulusSpans( center, inner_radius, outer_radius, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateAnnulusSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateAnnulusSpans( const Vector2<T> &center, double inner_radius, double outer_radius,
+                          Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateAnnulusSpans( center, inner_radius, outer_radius, min, max, min, max, functor );
+}
+
+template<typename T, typename Functor>
+bool iterateAnnulus( const Vector2<T> &center, double inner_radius, double outer_radius,
+                     Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                     Eigen::Index col_max, Functor functor )
+{
+  return iterateAnnulusSpans(
+      center, inner_radius, outer_radius, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+template<typename T, typename Functor>
+bool iterateAnnulusSpans( const Vector2<T> &center, double inner_radius, double outer_radius,
+                          Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                          Eigen::Index col_max, Functor functor )
+{
+  const Eigen::Index min_y =
+      std::max<Eigen::Index>( col_min, std::round( double( center.y() ) - outer_radius ) );
+  const Eigen::Index max_y =
+      std::min<Eigen::Index>( col_max, std::round( double( center.y() ) + outer_radius ) );
+  // Rows of the inner circle, computed as in iterateCircleSpans
+  const Eigen::Index inner_min_y = std::round( double( center.y() ) - inner_radius );
+  const Eigen::Index inner_max_y = std::round( double( center.y() ) + inner_radius );
+  const double outer_radius_squared = outer_radius * outer_radius;
+  const double inner_radius_squared = inner_radius * inner_radius;
+  const auto emit = [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+    x_start = std::max( x_start, row_min );
+    x_end = std::min( x_end, row_max );
+    return x_start >= x_end || detail::invokeIteratorFunctor( functor, y, x_start, x_end );
+  };
+  for ( Eigen::Index y = min_y; y < max_y; ++y ) {
+    const double delta_y = double( y ) + 0.5 - double( center.y() );
+    const double outer_width = std::sqrt( outer_radius_squared - delta_y * delta_y );
+    const Eigen::Index min_x = std::round( double( center.x() ) - outer_width );
+    const Eigen::Index max_x = std::round( double( center.x() ) + outer_width );
+    if ( inner_radius <= 0 || y < inner_min_y || y >= inner_max_y ) {
+      if ( !emit( y, min_x, max_x ) )
+        return false;
+      continue;
+    }
+    // The run of the inner circle in this row is cut out of the run of the outer circle
+    const double inner_width = std::sqrt( inner_radius_squared - delta_y * delta_y );
+    const Eigen::Index inner_min_x =
+        std::max<Eigen::Index>( min_x, std::round( double( center.x() ) - inner_width ) );
+    const Eigen::Index inner_max_x =
+        std::min<Eigen::Index>( max_x, std::round( double( center.x() ) + inner_width ) );
+    if ( inner_min_x >= inner_max_x ) {
+      if ( !emit( y, min_x, max_x ) )
+        return false;
+      continue;
+    }
+    if ( !emit( y, min_x, inner_min_x ) || !emit( y, inner_max_x, max_x ) )
+      return false;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_ANNULUS_ITERATOR_H
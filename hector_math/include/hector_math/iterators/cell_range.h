@@ -0,0 +1,292 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_CELL_RANGE_H
+#define HECTOR_MATH_CELL_RANGE_H
+
+#include "hector_math/iterators/circle_iterator.h"
+#include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/iterators/rectangle_iterator.h"
+#include "hector_math/types.h"
+#include <iterator>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * A range of the indexes (x, y) of a region, e.g., a polygon, circle or rectangle, that can be
+ * iterated using begin() and end() instead of passing a functor to the callback iterators.
+ * Hence, it can be used with range-based for loops and STL algorithms, iteration can be suspended
+ * by keeping an iterator, and multiple regions can be traversed interleaved.
+ *
+ * The region is rasterized once on construction using a span iterator and its cells are stored in
+ * the visiting order of the corresponding callback iterator. Hence, the memory is linear in the
+ * number of cells and the iterators are random access iterators that dereference to the cells
+ * stored in the range, e.g., to split the range for the parallel algorithms. The references are
+ * valid as long as the range exists.
+ * The runs [x_start, x_end) per row are stored as well. For tight loops over large regions,
+ * iterating the runs in spans() does not read the stored cells and is as fast as the callback
+ * iterators.
+ *
+ * Example:
+ * @code
+ * for ( const auto &cell : polygonRange( polygon, map.rows(), map.cols() ) )
+ *   sum += map( cell.x(), cell.y() );
+ * @endcode
+ */
+class CellRange
+{
+public:
+  struct Span {
+    Eigen::Index y;
+    Eigen::Index x_start;
+    Eigen::Index x_end;
+  };
+
+  class iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Vector2<Eigen::Index>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    iterator() = default;
+
+    //! @returns The x index of the current cell.
+    Eigen::Index x() const { return cell_->x(); }
+    //! @returns The y index of the current cell.
+    Eigen::Index y() const { return cell_->y(); }
+
+    reference operator*() const { return *cell_; }
+
+    pointer operator->() const { return cell_; }
+
+    reference operator[]( difference_type n ) const { return cell_[n]; }
+
+    iterator &operator++()
+    {
+      ++cell_;
+      return *this;
+    }
+
+    iterator operator++( int )
+    {
+      iterator result = *this;
+      ++cell_;
+      return result;
+    }
+
+    iterator &operator--()
+    {
+      --cell_;
+      return *this;
+    }
+
+    iterator operator--( int )
+    {
+      iterator result = *this;
+      --cell_;
+      return result;
+    }
+
+    iterator &operator+=( difference_type n )
+    {
+      cell_ += n;
+      return *this;
+    }
+
+    iterator &operator-=( difference_type n )
+    {
+      cell_ -= n;
+      return *this;
+    }
+
+    friend iterator operator+( iterator it, difference_type n ) { return it += n; }
+
+    friend iterator operator+( difference_type n, iterator it ) { return it += n; }
+
+    friend iterator operator-( iterator it, difference_type n ) { return it -= n; }
+
+    friend difference_type operator-( const iterator &a, const iterator &b )
+    {
+      return a.cell_ - b.cell_;
+    }
+
+    friend bool operator==( const iterator &a, const iterator &b ) { return a.cell_ == b.cell_; }
+
+    friend bool operator!=( const iterator &a, const iterator &b ) { return a.cell_ != b.cell_; }
+
+    friend bool operator<( const iterator &a, const iterator &b ) { return a.cell_ < b.cell_; }
+
+    friend bool operator>( const iterator &a, const iterator &b ) { return a.cell_ > b.cell_; }
+
+    friend bool operator<=( const iterator &a, const iterator &b ) { return a.cell_ <= b.cell_; }
+
+    friend bool operator>=( const iterator &a, const iterator &b ) { return a.cell_ >= b.cell_; }
+
+  private:
+    friend class CellRange;
+
+    explicit iterator( const value_type *cell ) : cell_( cell ) { }
+
+    const value_type *cell_ = nullptr;
+  };
+  using const_iterator = iterator;
+  using value_type = iterator::value_type;
+  using size_type = std::size_t;
+
+  CellRange() = default;
+
+  /*!
+   * Creates the range of the cells passed to the functor of the given span iterator.
+   * @tparam SpanIterator A function or lambda method that is called with a functor with the
+   *   signature void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end) and passes the runs
+   *   of the region to it, e.g., [&]( auto &&f ) { return iteratePolygonSpans( polygon, f ); }.
+   */
+  template<typename SpanIterator>
+  explicit CellRange( SpanIterator iterate_spans )
+  {
+    Eigen::Index count = 0;
+    iterate_spans( [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+      if ( x_start >= x_end )
+        return;
+      spans_.push_back( { y, x_start, x_end } );
+      count += x_end - x_start;
+    } );
+    // Allocate the cells once instead of growing the vector
+    cells_.resize( count );
+    value_type *cell = cells_.data();
+    for ( const Span &span : spans_ ) {
+      for ( Eigen::Index x = span.x_start; x < span.x_end; ++x, ++cell ) *cell = { x, span.y };
+    }
+  }
+
+  iterator begin() const { return iterator( cells_.data() ); }
+
+  iterator end() const { return iterator( cells_.data() + cells_.size() ); }
+
+  //! @returns The number of cells in the range.
+  size_type size() const { return cells_.size(); }
+
+  //! @returns True if the range does not contain any cell.
+  bool empty() const { return cells_.empty(); }
+
+  //! @returns The runs [x_start, x_end) per row y of the range in iteration order.
+  const std::vector<Span> &spans() const { return spans_; }
+
+private:
+  std::vector<Span> spans_;
+  Vector2List<Eigen::Index> cells_;
+};
+
+/*!
+ * Creates a CellRange of all indexes that lie in the given polygon. See iteratePolygon.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded.
+ * @param polygon The polygon whose cells are in the range.
+ * @return The range of the cells in the visiting order of iteratePolygon.
+ */
+template<typename T>
+CellRange polygonRange( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                        Eigen::Index col_min, Eigen::Index col_max )
+{
+  return CellRange( [&]( auto &&functor ) {
+    return iteratePolygonSpans( polygon, row_min, row_max, col_min, col_max, functor );
+  } );
+}
+
+//! Overload of polygonRange where row_min and col_min are set to 0 to allow for bounded iteration
+//! of 2D matrices and arrays.
+template<typename T>
+CellRange polygonRange( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols )
+{
+  return polygonRange( polygon, 0, rows, 0, cols );
+}
+
+//! Overload of polygonRange where the indexes are not bounded.
+template<typename T>
+CellRange polygonRange( const Polygon<T> &polygon )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return polygonRange( polygon, min, max, min, max );
+}
+
+/*!
+ * Creates a CellRange of all indexes that lie in the given circle. See iterateCircle.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded.
+ * @param center The center of the circle.
+ * @param radius The radius of the circle.
+ * @return The range of the cells in the visiting order of iterateCircle.
+ */
+template<typename T>
+CellRange circleRange( const Vector2<T> &center, double radius, Eigen::Index row_min,
+                       Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max )
+{
+  return CellRange( [&]( auto &&functor ) {
+    return iterateCircleSpans( center, radius, row_min, row_max, col_min, col_max, functor );
+  } );
+}
+
+//! Overload of circleRange where row_min and col_min are set to 0 to allow for bounded iteration
+//! of 2D matrices and arrays.
+template<typename T>
+CellRange circleRange( const Vector2<T> &center, double radius, Eigen::Index rows,
+                       Eigen::Index cols )
+{
+  return circleRange( center, radius, 0, rows, 0, cols );
+}
+
+//! Overload of circleRange where the indexes are not bounded.
+template<typename T>
+CellRange circleRange( const Vector2<T> &center, double radius )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return circleRange( center, radius, min, max, min, max );
+}
+
+/*!
+ * Creates a CellRange of all indexes that lie in the rectangle formed by the three points a, b and
+ * c where ab and ac form adjacent edges of the rectangle. See iterateRectangle.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded.
+ * @return The range of the cells in the visiting order of iterateRectangle.
+ */
+template<typename T>
+CellRange rectangleRange( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                          Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                          Eigen::Index col_max )
+{
+  return CellRange( [&]( auto &&functor ) {
+    return iterateRectangleSpans( a, b, c, row_min, row_max, col_min, col_max, functor );
+  } );
+}
+
+//! Overload of rectangleRange where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T>
+CellRange rectangleRange( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                          Eigen::Index rows, Eigen::Index cols )
+{
+  return rectangleRange( a, b, c, 0, rows, 0, cols );
+}
+
+//! Overload of rectangleRange where the indexes are not bounded.
+template<typename T>
+CellRange rectangleRange( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return rectangleRange( a, b, c, min, max, min, max );
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_CELL_RANGE_H
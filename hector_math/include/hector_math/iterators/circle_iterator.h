@@ -4,6 +4,7 @@
 #ifndef HECTOR_MATH_CIRCLE_ITERATOR_H
 #define HECTOR_MATH_CIRCLE_ITERATOR_H
 
+#include "hector_math/iterators/iterator_functor.h"
 #include "hector_math/types.h"
 
 namespace hector_math
@@ -20,33 +21,88 @@ namespace hector_math
  * @param center The center of the circle that is iterated over.
  * @param radius The radius of the circle that is iterated over.
  * @param functor The function that will be called for each index (x, y) inside the circle.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
  */
 template<typename T, typename Functor>
-void iterateCircle( const Vector2<T> &center, double radius, Eigen::Index row_min,
+bool iterateCircle( const Vector2<T> &center, double radius, Eigen::Index row_min,
                     Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
                     Functor functor );
 
 //! Overload of iterateCircle where row_min and col_min are set to 0 to allow for bounded iteration
 //! of 2D matrices and arrays.
 template<typename T, typename Functor>
-void iterateCircle( const Vector2<T> &center, double radius, Eigen::Index rows, Eigen::Index cols,
+bool iterateCircle( const Vector2<T> &center, double radius, Eigen::Index rows, Eigen::Index cols,
                     Functor functor )
 {
-  iterateCircle( center, radius, 0, rows, 0, cols, functor );
+  return iterateCircle( center, radius, 0, rows, 0, cols, functor );
 }
 
 //! Overload of iterateCircle where the indexes are not bounded.
 template<typename T, typename Functor>
-void iterateCircle( const Vector2<T> &center, double radius, Functor functor )
+bool iterateCircle( const Vector2<T> &center, double radius, Functor functor )
 {
   constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
   constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
-  iterateCircle( center, radius, min, max, min, max, functor );
+  return iterateCircle( center, radius, min, max, min, max, functor );
 }
 
+/*!
+ * Iterates over all indexes that lie in the given circle and for each row y calls the given functor
+ * once with the run of indexes [x_start, x_end) that lie in the circle.
+ * The same cells as in iterateCircle are visited, but instead of one call per cell, the functor
+ * receives the whole run which allows processing the corresponding segment of a column-major map,
+ * e.g., using <tt>map.col( y ).segment( x_start, x_end - x_start )</tt>.
+ * Empty runs are not passed to the functor.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param center The center of the circle that is iterated over.
+ * @param radius The radius of the circle that is iterated over.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateCircleSpans( const Vector2<T> &center, double radius, Eigen::Index row_min,
+                         Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                         Functor functor );
+
+//! Overload of iterateCircleSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateCircleSpans( const Vector2<T> &center, double radius, Eigen::Index rows,
+                         Eigen::Index cols, Functor functor )
+{
+  return iterateCircleSpans( center, radius, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateCircleSpans where the indexes are not bounded.
 template<typename T, typename Functor>
-void iterateCircle( const Vector2<T> &center, double radius, Eigen::Index row_min,
+bool iterateCircleSpans( const Vector2<T> &center, double radius, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateCircleSpans( center, radius, min, max, min, max, functor );
+}
+
+template<typename T, typename Functor>
+bool iterateCircle( const Vector2<T> &center, double radius, Eigen::Index row_min,
                     Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+{
+  return iterateCircleSpans(
+      center, radius, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+template<typename T, typename Functor>
+bool iterateCircleSpans( const Vector2<T> &center, double radius, Eigen::Index row_min,
+                         Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                         Functor functor )
 {
   const Eigen::Index min_y =
       std::max<Eigen::Index>( col_min, std::round( double( center.y() ) - radius ) );
@@ -61,8 +117,10 @@ void iterateCircle( const Vector2<T> &center, double radius, Eigen::Index row_mi
         std::max<Eigen::Index>( row_min, std::round( double( center.x() ) - width ) );
     const Eigen::Index max_x =
         std::min<Eigen::Index>( row_max, std::round( double( center.x() ) + width ) );
-    for ( Eigen::Index x = min_x; x < max_x; ++x ) { functor( x, y ); }
+    if ( min_x < max_x && !detail::invokeIteratorFunctor( functor, y, min_x, max_x ) )
+      return false;
   }
+  return true;
 }
 } // namespace hector_math
 
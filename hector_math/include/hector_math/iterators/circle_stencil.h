@@ -0,0 +1,254 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_CIRCLE_STENCIL_H
+#define HECTOR_MATH_CIRCLE_STENCIL_H
+
+#include "hector_math/iterators/circle_iterator.h"
+#include "hector_math/types.h"
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * Precomputed runs of a circle with a fixed radius for a number of discrete sub-cell offsets of
+ * the center. Iterating the circle at a center is then a table lookup and the runs are replayed
+ * with an integer offset instead of computing a square root and rounding per row.
+ *
+ * The fractional part of the center is discretized to the nearest multiple of 1 / subdivisions
+ * per axis. Hence, the visited cells are exactly those of iterateCircle if the fractional parts of
+ * the center are multiples of 1 / subdivisions, e.g., for the default of 4 subdivisions, circles
+ * centered at the center (x + 0.5, y + 0.5) or the corner (x, y) of a cell, and the circle is in
+ * the non-negative indexes, e.g., inside of a map.
+ * Otherwise, the cells of the circle at a center that is at most 0.5 / subdivisions away per axis
+ * are visited.
+ * Note: As for iterateCircle, the circle has to be in the index space.
+ */
+class CircleStencil
+{
+public:
+  struct Span {
+    Eigen::Index x_start;
+    Eigen::Index x_end;
+  };
+
+  CircleStencil() = default;
+
+  /*!
+   * @param radius The radius of the circle in the index space.
+   * @param subdivisions The number of discrete sub-cell offsets per axis.
+   */
+  explicit CircleStencil( double radius, int subdivisions = 4 )
+      : radius_( radius ), subdivisions_( subdivisions )
+  {
+    if ( subdivisions_ < 1 )
+      throw std::invalid_argument( "CircleStencil: subdivisions has to be at least 1!" );
+    stamp_y_start_.reserve( subdivisions_ * subdivisions_ );
+    stamp_offsets_.reserve( subdivisions_ * subdivisions_ + 1 );
+    stamp_offsets_.push_back( 0 );
+    // The rounding of iterateCircleSpans is not symmetric for negative values, hence, the stamps are
+    // rasterized at a positive offset to match iterateCircle for circles in the positive quadrant.
+    const Eigen::Index offset = static_cast<Eigen::Index>( std::ceil( radius_ ) ) + 1;
+    for ( int sub_y = 0; sub_y < subdivisions_; ++sub_y ) {
+      for ( int sub_x = 0; sub_x < subdivisions_; ++sub_x ) {
+        const Vector2<double> center( offset + double( sub_x ) / subdivisions_,
+                                      offset + double( sub_y ) / subdivisions_ );
+        // Rows without cells are stored as empty runs, hence, row i of a stamp is y_start + i
+        Eigen::Index y_start = 0;
+        Eigen::Index next_y = 0;
+        bool first = true;
+        iterateCircleSpans( center, radius_,
+                            [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                              if ( first ) {
+                                y_start = next_y = y;
+                                first = false;
+                              }
+                              for ( ; next_y < y; ++next_y ) spans_.push_back( { 0, 0 } );
+                              spans_.push_back( { x_start - offset, x_end - offset } );
+                              next_y = y + 1;
+                            } );
+        stamp_y_start_.push_back( y_start - offset );
+        stamp_offsets_.push_back( spans_.size() );
+      }
+    }
+  }
+
+  double radius() const { return radius_; }
+
+  int subdivisions() const { return subdivisions_; }
+
+  /*!
+   * Iterates over the runs of the circle at the given center and for each row y calls the functor
+   * once with the run [x_start, x_end). See iterateCircleSpans.
+   *
+   * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+   * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+   * @tparam Functor A function or lambda method with the signature:
+   *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+   * @param center The center of the circle in the index space.
+   * @return False if the iteration was stopped by the functor returning false, true otherwise.
+   */
+  template<typename T, typename Functor>
+  bool iterateSpans( const Vector2<T> &center, Eigen::Index row_min, Eigen::Index row_max,
+                     Eigen::Index col_min, Eigen::Index col_max, Functor functor ) const
+  {
+    if ( stamp_offsets_.empty() )
+      return true;
+    Eigen::Index x_offset, y_offset;
+    const int sub_x = discretize( double( center.x() ), x_offset );
+    const int sub_y = discretize( double( center.y() ), y_offset );
+    const int stamp = sub_y * subdivisions_ + sub_x;
+    const Span *spans = spans_.data() + stamp_offsets_[stamp];
+    const Eigen::Index row_count = stamp_offsets_[stamp + 1] - stamp_offsets_[stamp];
+    const Eigen::Index y0 = stamp_y_start_[stamp] + y_offset;
+    // Careful to not overflow if the bounds are the numeric limits
+    const Eigen::Index first_row = col_min > y0 ? col_min - y0 : 0;
+    const Eigen::Index last_row = col_max < y0 + row_count ? col_max - y0 : row_count;
+    for ( Eigen::Index row = first_row; row < last_row; ++row ) {
+      const Eigen::Index x_start = std::max<Eigen::Index>( row_min, spans[row].x_start + x_offset );
+      const Eigen::Index x_end = std::min<Eigen::Index>( row_max, spans[row].x_end + x_offset );
+      if ( x_start < x_end && !detail::invokeIteratorFunctor( functor, y0 + row, x_start, x_end ) )
+        return false;
+    }
+    return true;
+  }
+
+private:
+  //! Splits the coordinate into the cell index and the nearest discrete sub-cell offset.
+  int discretize( double value, Eigen::Index &index ) const
+  {
+    const double scaled = std::round( value * subdivisions_ );
+    const double cell = std::floor( scaled / subdivisions_ );
+    index = static_cast<Eigen::Index>( cell );
+    return std::min( subdivisions_ - 1, static_cast<int>( scaled - cell * subdivisions_ ) );
+  }
+
+  //! The runs of all stamps. The rows of stamp i are in [stamp_offsets_[i], stamp_offsets_[i+1]).
+  std::vector<Span> spans_;
+  std::vector<std::size_t> stamp_offsets_;
+  std::vector<Eigen::Index> stamp_y_start_;
+  double radius_ = 0;
+  int subdivisions_ = 1;
+};
+
+/*!
+ * A cache of CircleStencils for a set of radii, e.g., the few distinct inflation radii that are
+ * checked over and over again. The stencils are created on the first request of a radius.
+ * Note: Requesting a new radius modifies the cache, hence, it is not safe to request stencils
+ *   concurrently. References to stencils stay valid until the cache is cleared or destroyed.
+ */
+class CircleStencilCache
+{
+public:
+  //! @param subdivisions The number of discrete sub-cell offsets per axis of the stencils.
+  explicit CircleStencilCache( int subdivisions = 4 ) : subdivisions_( subdivisions ) { }
+
+  //! @return The stencil for the given radius. Creates it if it does not exist, yet.
+  const CircleStencil &stencil( double radius )
+  {
+    auto it = stencils_.find( radius );
+    if ( it == stencils_.end() )
+      it = stencils_.emplace( radius, CircleStencil( radius, subdivisions_ ) ).first;
+    return it->second;
+  }
+
+  int subdivisions() const { return subdivisions_; }
+
+  std::size_t size() const { return stencils_.size(); }
+
+  void clear() { stencils_.clear(); }
+
+private:
+  std::unordered_map<double, CircleStencil> stencils_;
+  int subdivisions_;
+};
+
+/*!
+ * Overload of iterateCircleSpans that replays the precomputed runs of the given stencil.
+ * See CircleStencil for the discretization of the center.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param stencil The stencil of the circle with the radius that is iterated over.
+ * @param center The center of the circle that is iterated over.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateCircleSpans( const CircleStencil &stencil, const Vector2<T> &center,
+                         Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                         Eigen::Index col_max, Functor functor )
+{
+  return stencil.iterateSpans( center, row_min, row_max, col_min, col_max, functor );
+}
+
+//! Overload of iterateCircleSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateCircleSpans( const CircleStencil &stencil, const Vector2<T> &center,
+                         Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateCircleSpans( stencil, center, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateCircleSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateCircleSpans( const CircleStencil &stencil, const Vector2<T> &center, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateCircleSpans( stencil, center, min, max, min, max, functor );
+}
+
+/*!
+ * Overload of iterateCircle that replays the precomputed runs of the given stencil and for each
+ * index (x, y) calls the given functor. See CircleStencil for the discretization of the center.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param stencil The stencil of the circle with the radius that is iterated over.
+ * @param center The center of the circle that is iterated over.
+ * @param functor The function that will be called for each index (x, y) inside the circle.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateCircle( const CircleStencil &stencil, const Vector2<T> &center, Eigen::Index row_min,
+                    Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                    Functor functor )
+{
+  return stencil.iterateSpans(
+      center, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+//! Overload of iterateCircle where row_min and col_min are set to 0 to allow for bounded iteration
+//! of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateCircle( const CircleStencil &stencil, const Vector2<T> &center, Eigen::Index rows,
+                    Eigen::Index cols, Functor functor )
+{
+  return iterateCircle( stencil, center, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateCircle where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateCircle( const CircleStencil &stencil, const Vector2<T> &center, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateCircle( stencil, center, min, max, min, max, functor );
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_CIRCLE_STENCIL_H
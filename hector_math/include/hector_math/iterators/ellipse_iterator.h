@@ -0,0 +1,148 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_ELLIPSE_ITERATOR_H
+#define HECTOR_MATH_ELLIPSE_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/types.h"
+
+namespace hector_math
+{
+/*!
+ * Iterates over all indexes that lie in the given ellipse and for each index (x, y) calls the given functor.
+ * This method will iterate all cells where the center of the cell (x+0.5, y+0.5) is inside the ellipse.
+ * The ellipse has the semi-axis radius_x along its x-axis and radius_y along its y-axis and is rotated by
+ * angle counter-clockwise, i.e., its x-axis points in direction (cos(angle), sin(angle)).
+ * Note: The ellipse has to be in the index space, hence, if it is in map coordinates it might be necessary to
+ *   divide it by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where row/col_min is included
+ * but row/col_max is excluded, i.e., the largest x index functor may be called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param center The center of the ellipse that is iterated over.
+ * @param radius_x The semi-axis of the ellipse along its x-axis.
+ * @param radius_y The semi-axis of the ellipse along its y-axis.
+ * @param angle The rotation of the ellipse in radians.
+ * @param functor The function that will be called for each index (x, y) inside the ellipse.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateEllipse( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                     Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                     Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateEllipse where row_min and col_min are set to 0 to allow for bounded iteration
+//! of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateEllipse( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                     Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateEllipse( center, radius_x, radius_y, angle, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateEllipse where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateEllipse( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                     Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateEllipse( center, radius_x, radius_y, angle, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the given ellipse and for each row y calls the given functor
+ * once with the run of indexes [x_start, x_end) that lie in the ellipse.
+ * The same cells as in iterateEllipse are visited. The run of each row is computed in closed form.
+ * Empty runs are not passed to the functor.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param center The center of the ellipse that is iterated over.
+ * @param radius_x The semi-axis of the ellipse along its x-axis.
+ * @param radius_y The semi-axis of the ellipse along its y-axis.
+ * @param angle The rotation of the ellipse in radians.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateEllipseSpans( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                          Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                          Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateEllipseSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateEllipseSpans( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                          Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateEllipseSpans( center, radius_x, radius_y, angle, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateEllipseSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateEllipseSpans( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                          Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateEllipseSpans( center, radius_x, radius_y, angle, min, max, min, max, functor );
+}
+
+template<typename T, typename Functor>
+bool iterateEllipse( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                     Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                     Eigen::Index col_max, Functor functor )
+{
+  return iterateEllipseSpans(
+      center, radius_x, radius_y, angle, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+template<typename T, typename Functor>
+bool iterateEllipseSpans( const Vector2<T> &center, double radius_x, double radius_y, double angle,
+                          Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                          Eigen::Index col_max, Functor functor )
+{
+  if ( radius_x <= 0 || radius_y <= 0 )
+    return true;
+  // A point (dx, dy) relative to the center is inside if a dx^2 + b dx dy + c dy^2 <= 1
+  const double cos_angle = std::cos( angle );
+  const double sin_angle = std::sin( angle );
+  const double inv_rx2 = 1 / ( radius_x * radius_x );
+  const double inv_ry2 = 1 / ( radius_y * radius_y );
+  const double a = cos_angle * cos_angle * inv_rx2 + sin_angle * sin_angle * inv_ry2;
+  const double b = 2 * cos_angle * sin_angle * ( inv_rx2 - inv_ry2 );
+  const double c = sin_angle * sin_angle * inv_rx2 + cos_angle * cos_angle * inv_ry2;
+  // Half of the extent in y direction
+  const double height = std::sqrt( radius_x * radius_x * sin_angle * sin_angle +
+                                   radius_y * radius_y * cos_angle * cos_angle );
+  const Eigen::Index min_y =
+      std::max<Eigen::Index>( col_min, std::round( double( center.y() ) - height ) );
+  const Eigen::Index max_y =
+      std::min<Eigen::Index>( col_max, std::round( double( center.y() ) + height ) );
+  for ( Eigen::Index y = min_y; y < max_y; ++y ) {
+    // Solve the quadratic equation a dx^2 + (b dy) dx + (c dy^2 - 1) = 0 for the limits of the row
+    const double delta_y = double( y ) + 0.5 - double( center.y() );
+    const double discriminant = b * b * delta_y * delta_y - 4 * a * ( c * delta_y * delta_y - 1 );
+    if ( discriminant < 0 )
+      continue;
+    const double mid = double( center.x() ) - b * delta_y / ( 2 * a );
+    const double width = std::sqrt( discriminant ) / ( 2 * a );
+    const Eigen::Index min_x = std::max<Eigen::Index>( row_min, std::round( mid - width ) );
+    const Eigen::Index max_x = std::min<Eigen::Index>( row_max, std::round( mid + width ) );
+    if ( min_x < max_x && !detail::invokeIteratorFunctor( functor, y, min_x, max_x ) )
+      return false;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_ELLIPSE_ITERATOR_H
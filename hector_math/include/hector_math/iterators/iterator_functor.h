@@ -0,0 +1,112 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_ITERATOR_FUNCTOR_H
+#define HECTOR_MATH_ITERATOR_FUNCTOR_H
+
+#include "hector_math/types.h"
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+namespace hector_math
+{
+namespace detail
+{
+/*!
+ * True if the functor returns bool when called with the given arguments.
+ * Iterators stop early if such a functor returns false. Functors returning void always iterate all
+ * indexes and the check is removed at compile time.
+ */
+template<typename Functor, typename... Args>
+struct is_stoppable_functor
+    : std::is_same<typename std::invoke_result<Functor &, Args...>::type, bool> {
+};
+
+//! Calls the functor with the given arguments.
+//! @return False if the iteration should stop, i.e., the functor returned false. Always true if the
+//!   functor returns void.
+template<typename Functor, typename... Args>
+inline bool invokeIteratorFunctor( Functor &functor, Args... args )
+{
+  if constexpr ( is_stoppable_functor<Functor, Args...>::value ) {
+    return functor( args... );
+  } else {
+    functor( args... );
+    return true;
+  }
+}
+
+/*!
+ * Calls the per-cell functor for each index x in the run [x_start, x_end) of row y.
+ * This is used to implement the per-cell iterators on top of their span variants.
+ * @return void if the functor returns void. Otherwise, false if the functor returned false in
+ *   which case the remaining indexes are skipped, true otherwise.
+ */
+template<typename Functor>
+inline auto iterateSpanCells( Functor &functor, Eigen::Index y, Eigen::Index x_start,
+                              Eigen::Index x_end )
+{
+  if constexpr ( is_stoppable_functor<Functor, Eigen::Index, Eigen::Index>::value ) {
+    for ( Eigen::Index x = x_start; x < x_end; ++x ) {
+      if ( !functor( x, y ) )
+        return false;
+    }
+    return true;
+  } else {
+    for ( Eigen::Index x = x_start; x < x_end; ++x ) { functor( x, y ); }
+  }
+}
+
+//! Rounds half away from zero like std::round but is inlined instead of calling into libm.
+//! The value has to be in the range of Eigen::Index.
+inline Eigen::Index roundToIndex( double value )
+{
+  auto result = static_cast<Eigen::Index>( value ); // Truncates towards zero
+  const double remainder = value - double( result );
+  if ( remainder >= 0.5 )
+    ++result;
+  else if ( remainder <= -0.5 )
+    --result;
+  return result;
+}
+
+//! Edge stepping of the scanline iterators where the x values of the edges are doubles.
+struct FloatingPointStepping {
+  using Value = double;
+
+  static Value fromDouble( double value ) { return value; }
+
+  static Eigen::Index toIndex( Value value )
+  {
+    return static_cast<Eigen::Index>( std::round( value ) );
+  }
+};
+
+/*!
+ * Edge stepping of the scanline iterators where the x values of the edges are 32.32 fixed-point
+ * integers. Stepping to the next row is an integer addition and rounding to the index is a shift,
+ * hence, there are no int/float conversions in the inner loop.
+ * The x values have to be in the range (-2^31, 2^31).
+ */
+struct FixedPointStepping {
+  using Value = std::int64_t;
+  static constexpr int FRACTION_BITS = 32;
+
+  static Value fromDouble( double value )
+  {
+    return roundToIndex( value * double( Value( 1 ) << FRACTION_BITS ) );
+  }
+
+  //! Rounds half away from zero like roundToIndex. Relies on the arithmetic right shift of signed
+  //! integers which all supported compilers implement.
+  static Eigen::Index toIndex( Value value )
+  {
+    constexpr Value half = Value( 1 ) << ( FRACTION_BITS - 1 );
+    return ( value + half - ( value < 0 ? 1 : 0 ) ) >> FRACTION_BITS;
+  }
+};
+} // namespace detail
+} // namespace hector_math
+
+#endif // HECTOR_MATH_ITERATOR_FUNCTOR_H
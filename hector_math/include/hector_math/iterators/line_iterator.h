@@ -0,0 +1,290 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_LINE_ITERATOR_H
+#define HECTOR_MATH_LINE_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/types.h"
+
+namespace hector_math
+{
+
+/*!
+ * Iterates over the cells of the line from the cell containing start to the cell containing end
+ * using Bresenham's line algorithm and for each index (x, y) calls the given functor.
+ * Exactly one cell is visited per step along the major axis, hence, the line is 8-connected and
+ * may skip cells that are only touched by the line. Use iterateLineSupercover if all cells touched
+ * by the line have to be visited, e.g., for raycasting.
+ * The cells are visited in order from start to end and both end cells are visited.
+ * Note: The line has to be in the index space, hence, if it is in map coordinates it might be
+ *   necessary to divide it by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1. The line is clipped to these ranges, hence, the cost depends only
+ * on the number of cells of the line inside of the ranges. The visited cells are the cells of the
+ * unclipped line that lie inside of the ranges. Nothing is visited if an end point is not finite.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param start The start point of the line.
+ * @param end The end point of the line.
+ * @param functor The function that will be called for each index (x, y) on the line.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateLine( const Vector2<T> &start, const Vector2<T> &end, Eigen::Index row_min,
+                  Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateLine where row_min and col_min are set to 0 to allow for bounded iteration
+//! of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateLine( const Vector2<T> &start, const Vector2<T> &end, Eigen::Index rows,
+                  Eigen::Index cols, Functor functor )
+{
+  return iterateLine( start, end, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateLine where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateLine( const Vector2<T> &start, const Vector2<T> &end, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateLine( start, end, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all cells touched by the line segment from start to end (supercover) and for each
+ * index (x, y) calls the given functor.
+ * The cells are traversed in the order the line passes through them using a digital differential
+ * analyzer. If the line passes exactly through a corner of a cell, both cells adjacent to the corner
+ * are visited before the diagonal cell, hence, consecutive cells are always 4-connected.
+ * Note: The line has to be in the index space, hence, if it is in map coordinates it might be
+ *   necessary to divide it by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1. The line is clipped to these ranges before the traversal.
+ * Nothing is visited if an end point is not finite.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param start The start point of the line.
+ * @param end The end point of the line.
+ * @param functor The function that will be called for each index (x, y) touched by the line.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateLineSupercover( const Vector2<T> &start, const Vector2<T> &end, Eigen::Index row_min,
+                            Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                            Functor functor );
+
+//! Overload of iterateLineSupercover where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateLineSupercover( const Vector2<T> &start, const Vector2<T> &end, Eigen::Index rows,
+                            Eigen::Index cols, Functor functor )
+{
+  return iterateLineSupercover( start, end, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateLineSupercover where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateLineSupercover( const Vector2<T> &start, const Vector2<T> &end, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateLineSupercover( start, end, min, max, min, max, functor );
+}
+
+namespace detail
+{
+//! Clips the parameter range [t_min, t_max] of the line origin + t * direction along one axis to
+//! the range [min, max]. Returns false if the clipped range is empty.
+inline bool clipLineAxis( double origin, double direction, double min, double max, double &t_min,
+                          double &t_max )
+{
+  if ( direction == 0 )
+    return origin >= min && origin <= max;
+  double t0 = ( min - origin ) / direction;
+  double t1 = ( max - origin ) / direction;
+  if ( t0 > t1 )
+    std::swap( t0, t1 );
+  t_min = std::max( t_min, t0 );
+  t_max = std::min( t_max, t1 );
+  return t_min <= t_max;
+}
+
+/*!
+ * Computes the range [first, last] of the number of steps k in [0, |end - start|] for which the
+ * index start + k * sign(end - start) lies in [min, max]. Returns false if the range is empty.
+ */
+inline bool clipLineSteps( Eigen::Index start, Eigen::Index end, Eigen::Index min, Eigen::Index max,
+                           Eigen::Index &first, Eigen::Index &last )
+{
+  if ( start <= end ) {
+    if ( end < min || start > max )
+      return false;
+    first = start >= min ? 0 : min - start;
+    last = end <= max ? end - start : max - start;
+    return true;
+  }
+  if ( start < min || end > max )
+    return false;
+  first = start <= max ? 0 : start - max;
+  last = end >= min ? start - end : start - min;
+  return true;
+}
+} // namespace detail
+
+template<typename T, typename Functor>
+bool iterateLine( const Vector2<T> &start, const Vector2<T> &end, Eigen::Index row_min,
+                  Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+{
+  if ( !start.allFinite() || !end.allFinite() )
+    return true;
+  // Reject lines that are entirely outside of the bounds (Liang-Barsky) before computing the cells.
+  // The cells of the line are less than one cell away from the line, hence, the bounds are extended.
+  const double direction_x = double( end.x() ) - start.x();
+  const double direction_y = double( end.y() ) - start.y();
+  double t_min = 0;
+  double t_max = 1;
+  if ( !detail::clipLineAxis( start.x(), direction_x, double( row_min ) - 1, double( row_max ) + 1,
+                              t_min, t_max ) ||
+       !detail::clipLineAxis( start.y(), direction_y, double( col_min ) - 1, double( col_max ) + 1,
+                              t_min, t_max ) )
+    return true;
+
+  const Eigen::Index x_start = std::floor( start.x() );
+  const Eigen::Index y_start = std::floor( start.y() );
+  const Eigen::Index x_end = std::floor( end.x() );
+  const Eigen::Index y_end = std::floor( end.y() );
+  const Eigen::Index dx = std::abs( x_end - x_start );
+  const Eigen::Index dy = std::abs( y_end - y_start );
+  // The ranges of steps along each axis for which the index is inside of the bounds
+  Eigen::Index first_x, last_x, first_y, last_y;
+  if ( !detail::clipLineSteps( x_start, x_end, row_min, row_max - 1, first_x, last_x ) ||
+       !detail::clipLineSteps( y_start, y_end, col_min, col_max - 1, first_y, last_y ) )
+    return true;
+
+  // One cell is visited per step along the major axis. After i steps, the line has made
+  // floor((2 * i * minor + major) / (2 * major)) steps along the minor axis.
+  const bool x_major = dx >= dy;
+  const Eigen::Index major = x_major ? dx : dy;
+  const Eigen::Index minor = x_major ? dy : dx;
+  Eigen::Index first = x_major ? first_x : first_y;
+  Eigen::Index last = x_major ? last_x : last_y;
+  const Eigen::Index first_minor = x_major ? first_y : first_x;
+  const Eigen::Index last_minor = x_major ? last_y : last_x;
+  if ( minor > 0 ) {
+    // The first and last major step for which the number of minor steps is in the clipped range
+    const Eigen::Index denominator = 2 * minor;
+    if ( first_minor > 0 )
+      first = std::max( first, ( ( 2 * first_minor - 1 ) * major + denominator - 1 ) / denominator );
+    if ( last_minor < minor )
+      last = std::min( last, ( ( 2 * last_minor + 1 ) * major + denominator - 1 ) / denominator - 1 );
+  }
+  if ( first > last )
+    return true;
+
+  // Start at the first cell inside of the bounds with the error term of the unclipped line
+  const Eigen::Index minor_steps = major == 0 ? 0 : ( 2 * first * minor + major ) / ( 2 * major );
+  const Eigen::Index steps_x = x_major ? first : minor_steps;
+  const Eigen::Index steps_y = x_major ? minor_steps : first;
+  const Eigen::Index step_x = x_start < x_end ? 1 : -1;
+  const Eigen::Index step_y = y_start < y_end ? 1 : -1;
+  Eigen::Index x = x_start + steps_x * step_x;
+  Eigen::Index y = y_start + steps_y * step_y;
+  Eigen::Index error = dx - dy - steps_x * dy + steps_y * dx;
+  if ( !detail::invokeIteratorFunctor( functor, x, y ) )
+    return false;
+  for ( Eigen::Index i = first; i < last; ++i ) {
+    const Eigen::Index error2 = 2 * error;
+    if ( error2 >= -dy ) {
+      error -= dy;
+      x += step_x;
+    }
+    if ( error2 <= dx ) {
+      error += dx;
+      y += step_y;
+    }
+    if ( !detail::invokeIteratorFunctor( functor, x, y ) )
+      return false;
+  }
+  return true;
+}
+
+template<typename T, typename Functor>
+bool iterateLineSupercover( const Vector2<T> &start, const Vector2<T> &end, Eigen::Index row_min,
+                            Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                            Functor functor )
+{
+  if ( !start.allFinite() || !end.allFinite() )
+    return true;
+  const double origin_x = start.x();
+  const double origin_y = start.y();
+  const double direction_x = double( end.x() ) - origin_x;
+  const double direction_y = double( end.y() ) - origin_y;
+  // Clip the line to the bounds (Liang-Barsky) to skip the part outside of the bounds
+  double t_min = 0;
+  double t_max = 1;
+  if ( !detail::clipLineAxis( origin_x, direction_x, row_min, row_max, t_min, t_max ) ||
+       !detail::clipLineAxis( origin_y, direction_y, col_min, col_max, t_min, t_max ) )
+    return true;
+
+  Eigen::Index x = std::floor( origin_x + t_min * direction_x );
+  Eigen::Index y = std::floor( origin_y + t_min * direction_y );
+  Eigen::Index x_end = std::floor( origin_x + t_max * direction_x );
+  Eigen::Index y_end = std::floor( origin_y + t_max * direction_y );
+  // The clipped end points may lie exactly on the upper bounds
+  x = std::min( std::max( x, row_min ), row_max - 1 );
+  y = std::min( std::max( y, col_min ), col_max - 1 );
+  x_end = std::min( std::max( x_end, row_min ), row_max - 1 );
+  y_end = std::min( std::max( y_end, col_min ), col_max - 1 );
+
+  const Eigen::Index step_x = direction_x > 0 ? 1 : -1;
+  const Eigen::Index step_y = direction_y > 0 ? 1 : -1;
+  // The line parameter t at which the next cell boundary in x and y direction is crossed and the
+  // difference in t between two boundaries.
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  const double t_delta_x = direction_x != 0 ? std::abs( 1 / direction_x ) : inf;
+  const double t_delta_y = direction_y != 0 ? std::abs( 1 / direction_y ) : inf;
+  double t_next_x =
+      direction_x != 0 ? ( double( x + ( step_x > 0 ? 1 : 0 ) ) - origin_x ) / direction_x : inf;
+  double t_next_y =
+      direction_y != 0 ? ( double( y + ( step_y > 0 ? 1 : 0 ) ) - origin_y ) / direction_y : inf;
+
+  // The number of remaining steps is known which guarantees termination despite rounding errors
+  Eigen::Index remaining_x = std::abs( x_end - x );
+  Eigen::Index remaining_y = std::abs( y_end - y );
+  if ( !detail::invokeIteratorFunctor( functor, x, y ) )
+    return false;
+  while ( remaining_x > 0 || remaining_y > 0 ) {
+    if ( remaining_y == 0 || ( remaining_x > 0 && t_next_x < t_next_y ) ) {
+      x += step_x;
+      t_next_x += t_delta_x;
+      --remaining_x;
+    } else if ( remaining_x == 0 || t_next_y < t_next_x ) {
+      y += step_y;
+      t_next_y += t_delta_y;
+      --remaining_y;
+    } else {
+      // The line passes exactly through the corner, visit both neighbors before the diagonal cell
+      if ( !detail::invokeIteratorFunctor( functor, x + step_x, y ) ||
+           !detail::invokeIteratorFunctor( functor, x, y + step_y ) )
+        return false;
+      x += step_x;
+      y += step_y;
+      t_next_x += t_delta_x;
+      t_next_y += t_delta_y;
+      --remaining_x;
+      --remaining_y;
+    }
+    if ( !detail::invokeIteratorFunctor( functor, x, y ) )
+      return false;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_LINE_ITERATOR_H
@@ -0,0 +1,228 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_MULTI_POLYGON_ITERATOR_H
+#define HECTOR_MATH_MULTI_POLYGON_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/types.h"
+#include <algorithm>
+#include <vector>
+
+namespace hector_math
+{
+
+//! The rule that determines which regions are inside a shape consisting of multiple rings.
+enum class FillRule : int {
+  //! A point is inside if a ray from the point to infinity crosses an odd number of edges.
+  //! Hence, a ring inside another ring is a hole independent of the orientation of the rings.
+  EvenOdd,
+  //! A point is inside if the winding number of the rings around the point is not zero.
+  //! Hence, a ring inside another ring is only a hole if it has the opposite orientation and
+  //! overlapping rings with the same orientation are merged.
+  NonZero
+};
+
+/*!
+ * Iterates over all indexes that lie in the shape formed by the given rings and for each row y
+ * calls the given functor once per run of consecutive indexes [x_start, x_end) inside the shape.
+ * All rings share a single edge table and are rasterized in one scanline pass, hence, each cell is
+ * visited at most once even if rings overlap, and holes or islands do not need to be subtracted.
+ * As for iteratePolygon, a cell is inside if its center (x+0.5, y+0.5) is inside the shape.
+ * Empty runs are not passed to the functor and touching runs of a row are merged.
+ * Note: The rings have to be in the index space, hence, if they are in map coordinates it might be
+ *   necessary to divide them by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param rings The closed rings that form the shape. Rings with less than 3 points are ignored.
+ * @param fill_rule The rule that determines which regions are inside the shape.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateMultiPolygonSpans( const PolygonList<T> &rings, FillRule fill_rule,
+                               Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                               Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateMultiPolygonSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateMultiPolygonSpans( const PolygonList<T> &rings, FillRule fill_rule, Eigen::Index rows,
+                               Eigen::Index cols, Functor functor )
+{
+  return iterateMultiPolygonSpans( rings, fill_rule, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateMultiPolygonSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateMultiPolygonSpans( const PolygonList<T> &rings, FillRule fill_rule, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateMultiPolygonSpans( rings, fill_rule, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the shape formed by the given rings and for each index
+ * (x, y) calls the given functor. See iterateMultiPolygonSpans.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param rings The closed rings that form the shape. Rings with less than 3 points are ignored.
+ * @param fill_rule The rule that determines which regions are inside the shape.
+ * @param functor The function that will be called for each index (x, y) inside the shape.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateMultiPolygon( const PolygonList<T> &rings, FillRule fill_rule, Eigen::Index row_min,
+                          Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                          Functor functor )
+{
+  return iterateMultiPolygonSpans(
+      rings, fill_rule, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+//! Overload of iterateMultiPolygon where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateMultiPolygon( const PolygonList<T> &rings, FillRule fill_rule, Eigen::Index rows,
+                          Eigen::Index cols, Functor functor )
+{
+  return iterateMultiPolygon( rings, fill_rule, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateMultiPolygon where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateMultiPolygon( const PolygonList<T> &rings, FillRule fill_rule, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateMultiPolygon( rings, fill_rule, min, max, min, max, functor );
+}
+
+template<typename T, typename Functor>
+bool iterateMultiPolygonSpans( const PolygonList<T> &rings, FillRule fill_rule,
+                               Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                               Eigen::Index col_max, Functor functor )
+{
+  struct Line {
+    double start_y;
+    double end_y;
+    double start_x;
+    double x_increment;
+    double x; // The x value at the center of the current row
+    int winding;
+  };
+  std::vector<Line> lines;
+  std::size_t line_count = 0;
+  for ( const auto &ring : rings ) line_count += ring.cols() < 3 ? 0 : ring.cols();
+  lines.reserve( line_count );
+  double max_y = std::numeric_limits<double>::lowest();
+  for ( const auto &ring : rings ) {
+    if ( ring.cols() < 3 )
+      continue;
+    for ( Eigen::Index i = 0; i < ring.cols(); ++i ) {
+      const auto &a = ring.col( i );
+      const auto &b = ring.col( i + 1 == ring.cols() ? 0 : i + 1 );
+      if ( a.y() == b.y() )
+        continue; // Horizontal lines are never crossed by the center line of a row
+      const bool upwards = a.y() < b.y();
+      Line line;
+      line.start_y = upwards ? a.y() : b.y();
+      line.end_y = upwards ? b.y() : a.y();
+      line.start_x = upwards ? a.x() : b.x();
+      line.x_increment = double( b.x() - a.x() ) / double( b.y() - a.y() );
+      line.winding = upwards ? 1 : -1;
+      max_y = std::max( max_y, line.end_y );
+      lines.push_back( line );
+    }
+  }
+  if ( lines.empty() )
+    return true;
+  std::sort( lines.begin(), lines.end(),
+             []( const Line &a, const Line &b ) { return a.start_y < b.start_y; } );
+
+  // A row y is crossed by a line if start_y < y + 0.5 <= end_y
+  Eigen::Index y = std::max( col_min, detail::roundToIndex( lines.front().start_y ) );
+  const Eigen::Index y_end = std::min( col_max, detail::roundToIndex( max_y ) );
+  const auto is_inside = [fill_rule]( int winding ) {
+    return fill_rule == FillRule::EvenOdd ? ( winding & 1 ) != 0 : winding != 0;
+  };
+  std::vector<Line> active_lines;
+  std::size_t next_line = 0;
+  for ( ; y < y_end; ++y ) {
+    const double y_center = double( y ) + 0.5;
+    // Remove ended lines while preserving the order and add the lines starting in this row
+    active_lines.erase( std::remove_if( active_lines.begin(), active_lines.end(),
+                                        [y_center]( const Line &line ) {
+                                          return line.end_y < y_center;
+                                        } ),
+                        active_lines.end() );
+    for ( ; next_line < lines.size() && lines[next_line].start_y < y_center; ++next_line ) {
+      if ( lines[next_line].end_y < y_center )
+        continue;
+      active_lines.push_back( lines[next_line] );
+    }
+    // Compute the x values for the current row and restore the order by x using an insertion sort
+    // which is linear for the nearly sorted active lines
+    for ( std::size_t i = 0; i < active_lines.size(); ++i ) {
+      Line &line = active_lines[i];
+      line.x = line.start_x + ( y_center - line.start_y ) * line.x_increment;
+      if ( i == 0 || active_lines[i - 1].x <= line.x )
+        continue;
+      const Line current = line;
+      std::size_t k = i;
+      for ( ; k > 0 && active_lines[k - 1].x > current.x; --k ) {
+        active_lines[k] = active_lines[k - 1];
+      }
+      active_lines[k] = current;
+    }
+
+    // Runs of different inside regions may touch after rounding, these are merged into one run
+    int winding = 0;
+    double span_start = 0;
+    Eigen::Index run_start = 0;
+    Eigen::Index run_end = 0;
+    for ( const Line &line : active_lines ) {
+      const bool was_inside = is_inside( winding );
+      winding += line.winding;
+      const bool inside = is_inside( winding );
+      if ( inside == was_inside )
+        continue;
+      if ( inside ) {
+        span_start = line.x;
+        continue;
+      }
+      const Eigen::Index x_start = std::max( row_min, detail::roundToIndex( span_start ) );
+      const Eigen::Index x_end = std::min( row_max, detail::roundToIndex( line.x ) );
+      if ( x_start >= x_end )
+        continue;
+      if ( run_start < run_end && x_start <= run_end ) {
+        run_end = std::max( run_end, x_end );
+        continue;
+      }
+      if ( run_start < run_end && !detail::invokeIteratorFunctor( functor, y, run_start, run_end ) )
+        return false;
+      run_start = x_start;
+      run_end = x_end;
+    }
+    if ( run_start < run_end && !detail::invokeIteratorFunctor( functor, y, run_start, run_end ) )
+      return false;
+    if ( active_lines.empty() && next_line == lines.size() )
+      break;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_MULTI_POLYGON_ITERATOR_H
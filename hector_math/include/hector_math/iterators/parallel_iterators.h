@@ -0,0 +1,165 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_PARALLEL_ITERATORS_H
+#define HECTOR_MATH_PARALLEL_ITERATORS_H
+
+#include "hector_math/iterators/circle_iterator.h"
+#include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/parallel/thread_pool.h"
+#include "hector_math/types.h"
+#include <exception>
+#include <vector>
+
+namespace hector_math
+{
+namespace detail
+{
+template<typename Functor, typename Reduction, typename BandIterator>
+Functor iterateBandsParallel( ThreadPool &pool, Eigen::Index y_min, Eigen::Index y_max,
+                              Functor functor, Reduction reduction, BandIterator iterate_band );
+}
+
+/*!
+ * Parallel variant of iteratePolygon which splits the y range of the polygon into bands that are
+ * iterated concurrently on the given thread pool.
+ * Each band is iterated using its own copy of the functor, hence, the functor does not need to be
+ * thread-safe as long as its state is held by value. After all bands were iterated, the copies are
+ * merged in the order of the bands (ascending y) using the reduction which makes the result
+ * deterministic if the reduction is.
+ * The calling thread iterates the first band itself and blocks until all bands are done. Hence,
+ * this method must not be called from a task running on the same pool.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A copyable function object with the signature:
+ *   void(Eigen::Index x, Eigen::Index y).
+ * @tparam Reduction A function or lambda method with the signature:
+ *   void(Functor &result, const Functor &band) that merges the state of band into result.
+ * @param pool The thread pool used to iterate the bands. The number of bands is the size of the
+ *   pool plus one for the calling thread but at most the number of rows.
+ * @param polygon The polygon that is iterated over.
+ * @param functor The prototype of the function object that is copied for each band.
+ * @param reduction The function that merges the band results.
+ * @return The merged functor or a copy of functor if the polygon does not contain any index in the
+ *   given bounds.
+ */
+template<typename T, typename Functor, typename Reduction>
+Functor iteratePolygonParallel( ThreadPool &pool, const Polygon<T> &polygon, Eigen::Index row_min,
+                                Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                                Functor functor, Reduction reduction )
+{
+  if ( polygon.cols() < 3 )
+    return functor;
+  const Eigen::Index y_min =
+      std::max<Eigen::Index>( col_min, std::round( double( polygon.row( 1 ).minCoeff() ) ) );
+  const Eigen::Index y_max =
+      std::min<Eigen::Index>( col_max, std::round( double( polygon.row( 1 ).maxCoeff() ) ) );
+  return detail::iterateBandsParallel(
+      pool, y_min, y_max, std::move( functor ), reduction,
+      [&]( Eigen::Index band_min, Eigen::Index band_max, Functor &band_functor ) {
+        iteratePolygon( polygon, row_min, row_max, band_min, band_max, std::ref( band_functor ) );
+      } );
+}
+
+//! Overload of iteratePolygonParallel where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor, typename Reduction>
+Functor iteratePolygonParallel( ThreadPool &pool, const Polygon<T> &polygon, Eigen::Index rows,
+                                Eigen::Index cols, Functor functor, Reduction reduction )
+{
+  return iteratePolygonParallel( pool, polygon, 0, rows, 0, cols, std::move( functor ), reduction );
+}
+
+/*!
+ * Parallel variant of iterateCircle which splits the y range of the circle into bands that are
+ * iterated concurrently on the given thread pool.
+ * See iteratePolygonParallel for the semantics of the functor copies and the reduction.
+ *
+ * @tparam Functor A copyable function object with the signature:
+ *   void(Eigen::Index x, Eigen::Index y).
+ * @tparam Reduction A function or lambda method with the signature:
+ *   void(Functor &result, const Functor &band) that merges the state of band into result.
+ * @param pool The thread pool used to iterate the bands. The number of bands is the size of the
+ *   pool plus one for the calling thread but at most the number of rows.
+ * @param center The center of the circle that is iterated over.
+ * @param radius The radius of the circle that is iterated over.
+ * @param functor The prototype of the function object that is copied for each band.
+ * @param reduction The function that merges the band results.
+ * @return The merged functor or a copy of functor if the circle does not contain any index in the
+ *   given bounds.
+ */
+template<typename T, typename Functor, typename Reduction>
+Functor iterateCircleParallel( ThreadPool &pool, const Vector2<T> &center, double radius,
+                               Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                               Eigen::Index col_max, Functor functor, Reduction reduction )
+{
+  const Eigen::Index y_min =
+      std::max<Eigen::Index>( col_min, std::round( double( center.y() ) - radius ) );
+  const Eigen::Index y_max =
+      std::min<Eigen::Index>( col_max, std::round( double( center.y() ) + radius ) );
+  return detail::iterateBandsParallel(
+      pool, y_min, y_max, std::move( functor ), reduction,
+      [&]( Eigen::Index band_min, Eigen::Index band_max, Functor &band_functor ) {
+        iterateCircle( center, radius, row_min, row_max, band_min, band_max,
+                       std::ref( band_functor ) );
+      } );
+}
+
+//! Overload of iterateCircleParallel where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor, typename Reduction>
+Functor iterateCircleParallel( ThreadPool &pool, const Vector2<T> &center, double radius,
+                               Eigen::Index rows, Eigen::Index cols, Functor functor,
+                               Reduction reduction )
+{
+  return iterateCircleParallel( pool, center, radius, 0, rows, 0, cols, std::move( functor ),
+                                reduction );
+}
+
+namespace detail
+{
+template<typename Functor, typename Reduction, typename BandIterator>
+Functor iterateBandsParallel( ThreadPool &pool, Eigen::Index y_min, Eigen::Index y_max,
+                              Functor functor, Reduction reduction, BandIterator iterate_band )
+{
+  if ( y_min >= y_max )
+    return functor;
+  // Each worker of the pool gets a band while the calling thread iterates the first band
+  const Eigen::Index band_count =
+      std::min<Eigen::Index>( static_cast<Eigen::Index>( pool.size() ) + 1, y_max - y_min );
+  std::vector<Functor> band_functors( band_count, functor );
+  std::vector<std::future<void>> futures;
+  futures.reserve( band_count - 1 );
+  // Distribute the rows as evenly as possible, the first bands get one additional row if needed
+  const Eigen::Index rows_per_band = ( y_max - y_min ) / band_count;
+  const Eigen::Index remainder = ( y_max - y_min ) % band_count;
+  Eigen::Index band_start = y_min + rows_per_band + ( remainder > 0 ? 1 : 0 );
+  for ( Eigen::Index i = 1; i < band_count; ++i ) {
+    const Eigen::Index band_end = band_start + rows_per_band + ( i < remainder ? 1 : 0 );
+    futures.push_back( pool.enqueue( [&iterate_band, &band_functors, i, band_start, band_end]() {
+      iterate_band( band_start, band_end, band_functors[i] );
+    } ) );
+    band_start = band_end;
+  }
+  // The first band is iterated by the calling thread.
+  // All bands have to be finished before returning since they reference the local functor copies.
+  std::exception_ptr error;
+  try {
+    iterate_band( y_min, y_min + rows_per_band + ( remainder > 0 ? 1 : 0 ), band_functors[0] );
+  } catch ( ... ) {
+    error = std::current_exception();
+  }
+  for ( auto &future : futures ) future.wait();
+  if ( error )
+    std::rethrow_exception( error );
+  for ( auto &future : futures ) future.get();
+
+  for ( Eigen::Index i = 1; i < band_count; ++i ) reduction( band_functors[0], band_functors[i] );
+  return band_functors[0];
+}
+} // namespace detail
+} // namespace hector_math
+
+#endif // HECTOR_MATH_PARALLEL_ITERATORS_H
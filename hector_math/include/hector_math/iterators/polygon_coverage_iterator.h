@@ -0,0 +1,310 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_POLYGON_COVERAGE_ITERATOR_H
+#define HECTOR_MATH_POLYGON_COVERAGE_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/types.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * Iterates over all indexes of cells that are (partially) covered by the given polygon and for each
+ * index (x, y) calls the given functor with the fraction of the cell's area that is covered by the
+ * polygon. In contrast to iteratePolygon, which only visits cells whose center is inside the
+ * polygon, this is an anti-aliased rasterization, i.e., the coverage is 1 for cells completely
+ * inside the polygon and in (0, 1) for cells on the boundary. Hence, the sum of the coverages is
+ * the area of the polygon (in cells) which allows a smooth integration of costs that does not
+ * depend on the position of the polygon relative to the grid.
+ * The cells are visited row by row (ascending y) and in ascending x inside a row.
+ * Note: The polygon has to be in the index space, hence, if it is in map coordinates it might be
+ *   necessary to divide it by the map resolution. The polygon must not be self-intersecting.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index x, Eigen::Index y, T coverage).
+ * @param polygon The polygon that is iterated over.
+ * @param functor The function that will be called for each index (x, y) covered by the polygon.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                             Eigen::Index col_min, Eigen::Index col_max, Functor functor );
+
+//! Overload of iteratePolygonCoverage where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols,
+                             Functor functor )
+{
+  return iteratePolygonCoverage( polygon, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iteratePolygonCoverage where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonCoverage( polygon, min, max, min, max, functor );
+}
+
+/*!
+ * Overload of iteratePolygonCoverage that passes runs of cells that are completely covered by the
+ * polygon to a separate span functor instead of calling the functor with a coverage of 1 for each
+ * of them. Hence, the cost depends on the number of cells on the boundary of the polygon and the
+ * number of rows but not on its area, and the interior runs of a column-major map can be processed
+ * in one go, e.g., using <tt>map.col( y ).segment( x_start, x_end - x_start )</tt>.
+ * The cells and runs are visited in the same order as the cells of iteratePolygonCoverage.
+ * Cells that are touched by an edge of the polygon are passed to the functor even if they are
+ * completely covered.
+ *
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index x, Eigen::Index y, T coverage).
+ * @tparam SpanFunctor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param polygon The polygon that is iterated over.
+ * @param functor The function that will be called for each partially covered index (x, y).
+ * @param span_functor The function that will be called for each run [x_start, x_end) in row y
+ *   that is completely covered by the polygon.
+ *   If one of the functors returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by a functor, true otherwise.
+ */
+template<typename T, typename Functor, typename SpanFunctor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                             Eigen::Index col_min, Eigen::Index col_max, Functor functor,
+                             SpanFunctor span_functor );
+
+//! Overload of iteratePolygonCoverage with a span functor where row_min and col_min are set to 0 to
+//! allow for bounded iteration of 2D matrices and arrays.
+template<typename T, typename Functor, typename SpanFunctor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols,
+                             Functor functor, SpanFunctor span_functor )
+{
+  return iteratePolygonCoverage( polygon, 0, rows, 0, cols, functor, span_functor );
+}
+
+//! Overload of iteratePolygonCoverage with a span functor where the indexes are not bounded.
+template<typename T, typename Functor, typename SpanFunctor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Functor functor, SpanFunctor span_functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonCoverage( polygon, min, max, min, max, functor, span_functor );
+}
+
+namespace detail
+{
+/*!
+ * Adds the signed area contribution of an edge segment inside a row to the accumulation buffer.
+ * The coverage of a cell is the absolute value of the prefix sum of the buffer up to that cell.
+ * This is the accumulation approach used by many font rasterizers.
+ * @param buffer The accumulation buffer where index 0 corresponds to the cell x_begin.
+ * @param x_begin The x index of the first cell in the buffer. Contributions left of it are added
+ *   to the first cell since they affect all cells to their right.
+ * @param xa The x coordinate of the segment at the top of the segment.
+ * @param xb The x coordinate of the segment at the bottom of the segment.
+ * @param d The signed height of the segment inside the row.
+ * @return The range [first, last] of buffer indexes that were modified. Empty if first > last.
+ */
+inline std::pair<Eigen::Index, Eigen::Index> accumulateCoverage( std::vector<double> &buffer,
+                                                                 Eigen::Index x_begin, double xa,
+                                                                 double xb, double d )
+{
+  const auto add = [&]( Eigen::Index x, double value ) {
+    const Eigen::Index index = std::max<Eigen::Index>( 0, x - x_begin );
+    if ( index < static_cast<Eigen::Index>( buffer.size() ) )
+      buffer[index] += value;
+  };
+  const double x0 = std::min( xa, xb );
+  const double x1 = std::max( xa, xb );
+  const double x0_floor = std::floor( x0 );
+  const auto x0i = static_cast<Eigen::Index>( x0_floor );
+  const double x1_ceil = std::ceil( x1 );
+  const auto x1i = static_cast<Eigen::Index>( x1_ceil );
+  const auto touched = [&]( Eigen::Index x_last ) {
+    const auto last_index = static_cast<Eigen::Index>( buffer.size() ) - 1;
+    return std::make_pair( std::max<Eigen::Index>( 0, x0i - x_begin ),
+                           std::min( last_index, std::max<Eigen::Index>( 0, x_last - x_begin ) ) );
+  };
+  if ( x1i <= x0i + 1 ) {
+    // The segment is inside a single cell
+    const double xmf = 0.5 * ( xa + xb ) - x0_floor;
+    add( x0i, d - d * xmf );
+    add( x0i + 1, d * xmf );
+    return touched( x0i + 1 );
+  }
+  // The segment spans multiple cells, distribute the area of the triangle and trapezoids
+  const double s = 1 / ( x1 - x0 );
+  const double x0f = x0 - x0_floor;
+  const double a0 = 0.5 * s * ( 1 - x0f ) * ( 1 - x0f );
+  const double x1f = x1 - x1_ceil + 1;
+  const double am = 0.5 * s * x1f * x1f;
+  add( x0i, d * a0 );
+  if ( x1i == x0i + 2 ) {
+    add( x0i + 1, d * ( 1 - a0 - am ) );
+  } else {
+    const double a1 = s * ( 1.5 - x0f );
+    add( x0i + 1, d * ( a1 - a0 ) );
+    for ( Eigen::Index x = x0i + 2; x < x1i - 1; ++x ) add( x, d * s );
+    const double a2 = a1 + double( x1i - x0i - 3 ) * s;
+    add( x1i - 1, d * ( 1 - a2 - am ) );
+  }
+  add( x1i, d * am );
+  return touched( x1i );
+}
+} // namespace detail
+
+template<typename T, typename Functor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                             Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+{
+  auto interior_functor = [&functor]( Eigen::Index x, Eigen::Index y ) {
+    return functor( x, y, T( 1 ) );
+  };
+  return iteratePolygonCoverage(
+      polygon, row_min, row_max, col_min, col_max, functor,
+      [&interior_functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( interior_functor, y, x_start, x_end );
+      } );
+}
+
+template<typename T, typename Functor, typename SpanFunctor>
+bool iteratePolygonCoverage( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                             Eigen::Index col_min, Eigen::Index col_max, Functor functor,
+                             SpanFunctor span_functor )
+{
+  if ( polygon.cols() < 3 )
+    return true;
+  struct Edge {
+    double x0, y0, x1, y1; // Oriented such that y0 < y1
+    double x_increment;
+    double direction;
+  };
+  std::vector<Edge> edges;
+  edges.reserve( polygon.cols() );
+  for ( Eigen::Index i = 0; i < polygon.cols(); ++i ) {
+    const auto &a = polygon.col( i );
+    const auto &b = polygon.col( i + 1 == polygon.cols() ? 0 : i + 1 );
+    if ( a.y() == b.y() )
+      continue; // Horizontal edges do not contribute
+    Edge edge;
+    const bool upwards = a.y() < b.y();
+    edge.x0 = upwards ? a.x() : b.x();
+    edge.y0 = upwards ? a.y() : b.y();
+    edge.x1 = upwards ? b.x() : a.x();
+    edge.y1 = upwards ? b.y() : a.y();
+    edge.x_increment = ( edge.x1 - edge.x0 ) / ( edge.y1 - edge.y0 );
+    edge.direction = upwards ? 1 : -1;
+    edges.push_back( edge );
+  }
+  if ( edges.empty() )
+    return true;
+  std::sort( edges.begin(), edges.end(),
+             []( const Edge &a, const Edge &b ) { return a.y0 < b.y0; } );
+
+  const Eigen::Index x_begin =
+      std::max<Eigen::Index>( row_min, std::floor( double( polygon.row( 0 ).minCoeff() ) ) );
+  const Eigen::Index x_end =
+      std::min<Eigen::Index>( row_max, std::ceil( double( polygon.row( 0 ).maxCoeff() ) ) );
+  if ( x_begin >= x_end )
+    return true;
+  Eigen::Index y = std::max<Eigen::Index>( col_min, std::floor( edges.front().y0 ) );
+  const Eigen::Index y_end =
+      std::min<Eigen::Index>( col_max, std::ceil( double( polygon.row( 1 ).maxCoeff() ) ) );
+  // Small values are the result of rounding errors
+  constexpr double epsilon = 1E-9;
+
+  // The buffer is only cleared at the indexes touched by the edges in a row
+  std::vector<double> buffer( x_end - x_begin, 0.0 );
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> touched;
+  std::vector<Edge> active_edges;
+  std::size_t next_edge = 0;
+  double accumulated = 0;
+  // Reports the cells [x_begin + first, x_begin + last) which are not touched by an edge, hence,
+  // their coverage is the current accumulated value.
+  const auto report_untouched = [&]( Eigen::Index y, Eigen::Index first, Eigen::Index last ) {
+    const double coverage = std::min( 1.0, std::abs( accumulated ) );
+    if ( coverage < epsilon )
+      return true;
+    if ( coverage > 1 - epsilon )
+      return detail::invokeIteratorFunctor( span_functor, y, x_begin + first, x_begin + last );
+    for ( Eigen::Index i = first; i < last; ++i ) {
+      if ( !detail::invokeIteratorFunctor( functor, x_begin + i, y, static_cast<T>( coverage ) ) )
+        return false;
+    }
+    return true;
+  };
+  for ( ; y < y_end; ++y ) {
+    const double row_top = y;
+    const double row_bottom = y + 1;
+    // Remove ended edges and add new edges that start in this row
+    active_edges.erase(
+        std::remove_if( active_edges.begin(), active_edges.end(),
+                        [row_top]( const Edge &edge ) { return edge.y1 <= row_top; } ),
+        active_edges.end() );
+    for ( ; next_edge < edges.size() && edges[next_edge].y0 < row_bottom; ++next_edge ) {
+      // The edge may have ended before this row if the iteration started later due to col_min
+      if ( edges[next_edge].y1 <= row_top )
+        continue;
+      active_edges.push_back( edges[next_edge] );
+    }
+    if ( active_edges.empty() ) {
+      if ( next_edge == edges.size() )
+        break;
+      continue;
+    }
+
+    touched.clear();
+    for ( const Edge &edge : active_edges ) {
+      const double segment_top = std::max( row_top, edge.y0 );
+      const double segment_bottom = std::min( row_bottom, edge.y1 );
+      if ( segment_bottom <= segment_top )
+        continue;
+      const double xa = edge.x0 + ( segment_top - edge.y0 ) * edge.x_increment;
+      const double xb = edge.x0 + ( segment_bottom - edge.y0 ) * edge.x_increment;
+      const auto range = detail::accumulateCoverage(
+          buffer, x_begin, xa, xb, ( segment_bottom - segment_top ) * edge.direction );
+      if ( range.first <= range.second )
+        touched.push_back( range );
+    }
+    std::sort( touched.begin(), touched.end() );
+    // The touched cells are reported individually, the coverage between them is constant
+    accumulated = 0;
+    Eigen::Index next = 0;
+    for ( std::size_t k = 0; k < touched.size(); ) {
+      const Eigen::Index first = touched[k].first;
+      Eigen::Index last = touched[k].second;
+      for ( ++k; k < touched.size() && touched[k].first <= last + 1; ++k )
+        last = std::max( last, touched[k].second );
+      if ( first > next && !report_untouched( y, next, first ) )
+        return false;
+      for ( Eigen::Index i = first; i <= last; ++i ) {
+        accumulated += buffer[i];
+        buffer[i] = 0;
+        const double coverage = std::min( 1.0, std::abs( accumulated ) );
+        if ( coverage < epsilon )
+          continue;
+        const T value = coverage > 1 - epsilon ? T( 1 ) : static_cast<T>( coverage );
+        if ( !detail::invokeIteratorFunctor( functor, x_begin + i, y, value ) )
+          return false;
+      }
+      next = last + 1;
+    }
+    const auto size = static_cast<Eigen::Index>( buffer.size() );
+    if ( next < size && !report_untouched( y, next, size ) )
+      return false;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_POLYGON_COVERAGE_ITERATOR_H
@@ -5,7 +5,9 @@
 #define HECTOR_MATH_POLYGON_ITERATOR_H
 
 #include "hector_math/containers/bounded_vector.h"
+#include "hector_math/iterators/iterator_functor.h"
 #include "hector_math/types.h"
+#include <array>
 #include <vector>
 
 namespace hector_math
@@ -23,56 +25,355 @@ namespace hector_math
  * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
  * @param polygon The polygon that is iterated over.
  * @param functor The function that will be called for each index (x, y) inside the polygon.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
  */
 template<typename T, typename Functor>
-void iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+bool iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
                      Eigen::Index col_min, Eigen::Index col_max, Functor functor );
 
 //! Overload of iteratePolygon where row_min and col_min are set to 0 to allow for bounded iteration
 //! of 2D matrices and arrays.
 template<typename T, typename Functor>
-void iteratePolygon( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols, Functor functor )
+bool iteratePolygon( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols, Functor functor )
 {
-  iteratePolygon( polygon, 0, rows, 0, cols, functor );
+  return iteratePolygon( polygon, 0, rows, 0, cols, functor );
 }
 
 //! Overload of iteratePolygon where the indexes are not bounded.
 template<typename T, typename Functor>
-void iteratePolygon( const Polygon<T> &polygon, Functor functor )
+bool iteratePolygon( const Polygon<T> &polygon, Functor functor )
 {
   constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
   constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
-  iteratePolygon( polygon, min, max, min, max, functor );
+  return iteratePolygon( polygon, min, max, min, max, functor );
 }
 
-namespace detail
+/*!
+ * Iterates over all indexes that lie in the given polygon and for each row y calls the given functor
+ * once per run of consecutive indexes [x_start, x_end) that lie in the polygon.
+ * The same cells as in iteratePolygon are visited, but instead of one call per cell, the functor
+ * receives the whole run which allows processing the corresponding segment of a column-major map,
+ * e.g., using <tt>map.col( y ).segment( x_start, x_end - x_start )</tt>.
+ * Empty runs are not passed to the functor.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param polygon The polygon that is iterated over.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iteratePolygonSpans( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                          Eigen::Index col_min, Eigen::Index col_max, Functor functor );
+
+//! Overload of iteratePolygonSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iteratePolygonSpans( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols,
+                          Functor functor )
 {
-template<typename T, typename Functor, int LIMIT = 0>
-void iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
-                     Eigen::Index col_min, Eigen::Index col_max, Functor functor );
+  return iteratePolygonSpans( polygon, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iteratePolygonSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iteratePolygonSpans( const Polygon<T> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonSpans( polygon, min, max, min, max, functor );
+}
+
+/*!
+ * Overload of iteratePolygonSpans for polygons with a number of vertices N that is known at compile
+ * time, e.g., a robot footprint stored as Eigen::Array<T, 2, 4>.
+ * The iteration is specialized for N, i.e., the loops over the edges have a constant trip count and
+ * the edge tables are stored on the stack without dispatching on the number of vertices at runtime.
+ * The same cells as for the dynamically sized polygon are visited.
+ */
+template<typename T, int N, typename Functor>
+bool iteratePolygonSpans( const Eigen::Array<T, 2, N> &polygon, Eigen::Index row_min,
+                          Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                          Functor functor );
+
+//! Overload of iteratePolygonSpans for fixed size polygons where row_min and col_min are set to 0.
+template<typename T, int N, typename Functor>
+bool iteratePolygonSpans( const Eigen::Array<T, 2, N> &polygon, Eigen::Index rows,
+                          Eigen::Index cols, Functor functor )
+{
+  return iteratePolygonSpans( polygon, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iteratePolygonSpans for fixed size polygons where the indexes are not bounded.
+template<typename T, int N, typename Functor>
+bool iteratePolygonSpans( const Eigen::Array<T, 2, N> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonSpans( polygon, min, max, min, max, functor );
+}
+
+//! Overload of iteratePolygon for polygons with a number of vertices N that is known at compile
+//! time. See the fixed size overload of iteratePolygonSpans.
+template<typename T, int N, typename Functor>
+bool iteratePolygon( const Eigen::Array<T, 2, N> &polygon, Eigen::Index row_min,
+                     Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                     Functor functor )
+{
+  return iteratePolygonSpans(
+      polygon, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+//! Overload of iteratePolygon for fixed size polygons where row_min and col_min are set to 0.
+template<typename T, int N, typename Functor>
+bool iteratePolygon( const Eigen::Array<T, 2, N> &polygon, Eigen::Index rows, Eigen::Index cols,
+                     Functor functor )
+{
+  return iteratePolygon( polygon, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iteratePolygon for fixed size polygons where the indexes are not bounded.
+template<typename T, int N, typename Functor>
+bool iteratePolygon( const Eigen::Array<T, 2, N> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygon( polygon, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the given polygon and for each row y calls the given functor
+ * once per run of consecutive indexes [x_start, x_end) that lie in the polygon.
+ * Same as iteratePolygonSpans but the x values of the edges are stepped from row to row as 32.32
+ * fixed-point integers instead of doubles. Hence, the inner loop consists only of integer additions
+ * and shifts without int/float conversions.
+ * The visited cells are the same as for iteratePolygonSpans unless the center of a cell lies within
+ * the fixed-point precision, i.e., about n * 2^-32 after n rows, of the polygon's border.
+ * Note: The x values of the polygon have to be in the range (-2^31, 2^31).
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param polygon The polygon that is iterated over.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iteratePolygonSpansFixedPoint( const Polygon<T> &polygon, Eigen::Index row_min,
+                                    Eigen::Index row_max, Eigen::Index col_min,
+                                    Eigen::Index col_max, Functor functor );
+
+//! Overload of iteratePolygonSpansFixedPoint where row_min and col_min are set to 0 to allow for
+//! bounded iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iteratePolygonSpansFixedPoint( const Polygon<T> &polygon, Eigen::Index rows,
+                                    Eigen::Index cols, Functor functor )
+{
+  return iteratePolygonSpansFixedPoint( polygon, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iteratePolygonSpansFixedPoint where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iteratePolygonSpansFixedPoint( const Polygon<T> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonSpansFixedPoint( polygon, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the given polygon and for each index (x, y) calls the given
+ * functor. See iteratePolygonSpansFixedPoint.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param polygon The polygon that is iterated over.
+ * @param functor The function that will be called for each index (x, y) inside the polygon.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iteratePolygonFixedPoint( const Polygon<T> &polygon, Eigen::Index row_min,
+                               Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                               Functor functor )
+{
+  return iteratePolygonSpansFixedPoint(
+      polygon, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+//! Overload of iteratePolygonFixedPoint where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iteratePolygonFixedPoint( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols,
+                               Functor functor )
+{
+  return iteratePolygonFixedPoint( polygon, 0, rows, 0, cols, functor );
 }
 
+//! Overload of iteratePolygonFixedPoint where the indexes are not bounded.
 template<typename T, typename Functor>
-void iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+bool iteratePolygonFixedPoint( const Polygon<T> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonFixedPoint( polygon, min, max, min, max, functor );
+}
+
+namespace detail
+{
+template<typename Stepping, typename T, typename Functor>
+bool iterateSteppedPolygonSpans( const Polygon<T> &polygon, Eigen::Index row_min,
+                                 Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                                 Functor functor );
+
+template<typename T, typename Functor, int LIMIT = 0, typename Stepping = FloatingPointStepping>
+bool iteratePolygonSpans( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                          Eigen::Index col_min, Eigen::Index col_max, Functor functor );
+
+template<typename T, int N, typename Functor>
+bool iterateFixedSizePolygonSpans( const Eigen::Array<T, 2, N> &polygon, Eigen::Index row_min,
+                                   Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                                   Functor functor );
+
+template<typename Derived>
+bool clipPolygonRows( const Eigen::DenseBase<Derived> &polygon, Eigen::Index row_min,
+                      Eigen::Index row_max, Eigen::Index &col_min, Eigen::Index &col_max );
+} // namespace detail
+
+template<typename T, typename Functor>
+bool iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
                      Eigen::Index col_min, Eigen::Index col_max, Functor functor )
 {
-  if ( polygon.cols() < 3 )
-    return;
-  if ( polygon.cols() <= 15 ) {
-    detail::iteratePolygon<T, Functor, 15>( polygon, row_min, row_max, col_min, col_max, functor );
-  } else if ( polygon.cols() <= 63 ) {
-    detail::iteratePolygon<T, Functor, 63>( polygon, row_min, row_max, col_min, col_max, functor );
+  return iteratePolygonSpans(
+      polygon, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+template<typename T, typename Functor>
+bool iteratePolygonSpans( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                          Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+{
+  return detail::iterateSteppedPolygonSpans<detail::FloatingPointStepping>(
+      polygon, row_min, row_max, col_min, col_max, functor );
+}
+
+template<typename T, typename Functor>
+bool iteratePolygonSpansFixedPoint( const Polygon<T> &polygon, Eigen::Index row_min,
+                                    Eigen::Index row_max, Eigen::Index col_min,
+                                    Eigen::Index col_max, Functor functor )
+{
+  return detail::iterateSteppedPolygonSpans<detail::FixedPointStepping>(
+      polygon, row_min, row_max, col_min, col_max, functor );
+}
+
+template<typename T, int N, typename Functor>
+bool iteratePolygonSpans( const Eigen::Array<T, 2, N> &polygon, Eigen::Index row_min,
+                          Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                          Functor functor )
+{
+  static_assert( N != Eigen::Dynamic, "Dynamically sized polygons use the Polygon<T> overload." );
+  if constexpr ( N < 3 ) {
+    return true;
   } else {
-    detail::iteratePolygon<T, Functor>( polygon, row_min, row_max, col_min, col_max, functor );
+    if ( !detail::clipPolygonRows( polygon, row_min, row_max, col_min, col_max ) )
+      return true;
+    return detail::iterateFixedSizePolygonSpans( polygon, row_min, row_max, col_min, col_max,
+                                                 functor );
   }
 }
 
 namespace detail
 {
-template<typename T, typename Functor, int LIMIT>
-void iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
-                     Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+template<typename Stepping, typename T, typename Functor>
+bool iterateSteppedPolygonSpans( const Polygon<T> &polygon, Eigen::Index row_min,
+                                 Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                                 Functor functor )
+{
+  if ( polygon.cols() < 3 || !clipPolygonRows( polygon, row_min, row_max, col_min, col_max ) )
+    return true;
+  if ( polygon.cols() <= 15 ) {
+    return iteratePolygonSpans<T, Functor, 15, Stepping>( polygon, row_min, row_max, col_min,
+                                                          col_max, functor );
+  } else if ( polygon.cols() <= 63 ) {
+    return iteratePolygonSpans<T, Functor, 63, Stepping>( polygon, row_min, row_max, col_min,
+                                                          col_max, functor );
+  }
+  return iteratePolygonSpans<T, Functor, 0, Stepping>( polygon, row_min, row_max, col_min, col_max,
+                                                       functor );
+}
+
+/*!
+ * Clips the polygon against the bounds and restricts the rows [col_min, col_max) to the rows that
+ * can contain cells of the polygon inside the bounds.
+ * The edges are clipped against the slab row_min <= x <= row_max and the extent in y of the
+ * clipped edges is the extent of the polygon clipped with Sutherland-Hodgman. Only the range of
+ * rows is computed from it, the rasterization still uses the original edges, hence, the visited
+ * cells do not change.
+ * @return False if no cell of the polygon is inside the bounds.
+ */
+template<typename Derived>
+bool clipPolygonRows( const Eigen::DenseBase<Derived> &polygon, Eigen::Index row_min,
+                      Eigen::Index row_max, Eigen::Index &col_min, Eigen::Index &col_max )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  const bool bounded_x = row_min != min || row_max != max;
+  const double x_min = row_min;
+  const double x_max = row_max;
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+  for ( Eigen::Index i = 0; i < polygon.cols(); ++i ) {
+    const Eigen::Index j = i + 1 == polygon.cols() ? 0 : i + 1;
+    double ax = polygon( 0, i ), ay = polygon( 1, i );
+    double bx = polygon( 0, j ), by = polygon( 1, j );
+    if ( bounded_x ) {
+      if ( ax > bx ) {
+        std::swap( ax, bx );
+        std::swap( ay, by );
+      }
+      if ( bx < x_min || ax > x_max )
+        continue; // Edge is outside of the slab
+      if ( ax < x_min ) {
+        ay += ( x_min - ax ) / ( bx - ax ) * ( by - ay );
+        ax = x_min;
+      }
+      if ( bx > x_max )
+        by = ay + ( x_max - ax ) / ( bx - ax ) * ( by - ay );
+    }
+    min_y = std::min( min_y, std::min( ay, by ) );
+    max_y = std::max( max_y, std::max( ay, by ) );
+  }
+  if ( min_y > max_y )
+    return false;
+  // The rows are extended by one to be robust against rounding errors in the clipping
+  if ( min_y > double( col_min ) + 1 )
+    col_min = roundToIndex( min_y ) - 1;
+  if ( max_y < double( col_max ) - 1 )
+    col_max = roundToIndex( max_y ) + 1;
+  return col_min < col_max;
+}
+
+template<typename T, typename Functor, int LIMIT, typename Stepping>
+bool iteratePolygonSpans( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                          Eigen::Index col_min, Eigen::Index col_max, Functor functor )
 {
+  using Value = typename Stepping::Value;
   // Build iteration lines from the polygon points that allow us to get the x value for each
   // discrete y index in the map
   struct Line {
@@ -85,26 +386,25 @@ void iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Ind
       if ( a.y() > b.y() )
         std::swap( start, end );
       T diff_y = b.y() - a.y();
-      if ( std::abs( diff_y ) < 1E-4 )
-        x_increment = 0;
-      else
-        x_increment = double( b.x() - a.x() ) / double( b.y() - a.y() );
+      double increment = 0;
+      if ( std::abs( diff_y ) >= 1E-4 )
+        increment = double( b.x() - a.x() ) / double( b.y() - a.y() );
 
       // Compute x value at center of y-column
-      x = start.x() + ( 0.5 - ( start.y() - std::floor( start.y() ) ) ) * x_increment;
+      x = Stepping::fromDouble( start.x() +
+                                ( 0.5 - ( start.y() - std::floor( start.y() ) ) ) * increment );
+      x_increment = Stepping::fromDouble( increment );
       start_y = start.y();
       end_y = end.y();
     }
 
     double start_y;
     double end_y;
-    double x;
-    double x_increment;
+    Value x;
+    Value x_increment;
   };
   using LineContainer =
       typename std::conditional<LIMIT == 0, std::vector<Line>, BoundedVector<Line, LIMIT + 1>>::type;
-  using RegionContainer = typename std::conditional<LIMIT == 0, std::vector<Eigen::Index>,
-                                                    BoundedVector<Eigen::Index, LIMIT>>::type;
 
   LineContainer lines;
   lines.reserve( polygon.cols() );
@@ -123,45 +423,149 @@ void iteratePolygon( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Ind
   std::sort( lines.begin(), lines.end(),
              []( const Line &a, const Line &b ) { return a.start_y < b.start_y; } );
   std::size_t active_line_index = 0;
+  // The active edge table. It is kept sorted by the x value of the lines in the current row.
   LineContainer active_lines;
-  RegionContainer x_region_segments;
+  active_lines.reserve( polygon.cols() );
 
   Eigen::Index y = std::max<Eigen::Index>( col_min, std::round( lines[active_line_index].start_y ) );
   for ( ; y < max_y; ++y ) {
     const double y_cell_limit = double( y ) + 0.5;
-    // Determine lines that ended
-    for ( int i = active_lines.size() - 1; i >= 0; --i ) {
-      active_lines[i].x += active_lines[i].x_increment;
-      if ( active_lines[i].end_y >= y_cell_limit )
+    // Remove lines that ended and advance the remaining lines to the current row.
+    // The compaction preserves the order of the remaining lines.
+    std::size_t active_count = 0;
+    for ( std::size_t i = 0; i < active_lines.size(); ++i ) {
+      if ( active_lines[i].end_y < y_cell_limit )
         continue;
-      active_lines.erase( active_lines.begin() + i );
+      active_lines[active_count] = active_lines[i];
+      active_lines[active_count].x += active_lines[active_count].x_increment;
+      ++active_count;
     }
+    active_lines.erase( active_lines.begin() + active_count, active_lines.end() );
     // Determine new lines that started
     for ( ; active_line_index < lines.size(); ++active_line_index ) {
       if ( lines[active_line_index].start_y >= y_cell_limit )
         break;
       if ( lines[active_line_index].end_y < y_cell_limit )
         continue; // Ignore lines that start and end before current column
-      if ( lines[active_line_index].start_y < y )
-        lines[active_line_index].x += lines[active_line_index].x_increment;
-      active_lines.push_back( lines[active_line_index] );
+      // The x value is at the center of the start row. Advance it to the current row which is not
+      // necessarily the next row if the iteration started later due to the col_min limit.
+      Line &line = lines[active_line_index];
+      line.x += Value( double( y ) - std::floor( line.start_y ) ) * line.x_increment;
+      active_lines.push_back( line );
     }
 
-    // We obtain from each line the x for the current y and use that information to iterate between
-    // each pair of x(k) -> x(k+1) where k = 2 * i and i is a natural integer
-    x_region_segments.clear();
-    for ( std::size_t i = 0; i < active_lines.size(); ++i ) {
-      Eigen::Index x = std::round( active_lines[i].x );
-      x_region_segments.push_back( x );
+    // Restore the order by x using an insertion sort. Lines only change their order if they
+    // intersect and new lines were appended at the end, hence, the active lines are nearly sorted
+    // and this is linear in the number of active lines in the common case.
+    for ( std::size_t i = 1; i < active_lines.size(); ++i ) {
+      if ( active_lines[i - 1].x <= active_lines[i].x )
+        continue;
+      const Line line = active_lines[i];
+      std::size_t k = i;
+      for ( ; k > 0 && active_lines[k - 1].x > line.x; --k ) active_lines[k] = active_lines[k - 1];
+      active_lines[k] = line;
+    }
+
+    // We obtain from each line the x for the current y and iterate between each pair of
+    // x(k) -> x(k+1) where k = 2 * i and i is a natural integer
+    for ( std::size_t i = 0; i + 1 < active_lines.size(); i += 2 ) {
+      const Eigen::Index x_start =
+          std::max<Eigen::Index>( row_min, Stepping::toIndex( active_lines[i].x ) );
+      const Eigen::Index x_end =
+          std::min<Eigen::Index>( row_max, Stepping::toIndex( active_lines[i + 1].x ) );
+      if ( x_start < x_end && !invokeIteratorFunctor( functor, y, x_start, x_end ) )
+        return false;
+    }
+  }
+  return true;
+}
+
+template<typename T, int N, typename Functor>
+bool iterateFixedSizePolygonSpans( const Eigen::Array<T, 2, N> &polygon, Eigen::Index row_min,
+                                   Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                                   Functor functor )
+{
+  // Same algorithm as iteratePolygonSpans but all loops over the edges have a compile time trip
+  // count and the edge tables are plain arrays, hence, there are no capacity checks or allocations.
+  struct Line {
+    double start_y;
+    double end_y;
+    double x;
+    double x_increment;
+  };
+  std::array<Line, N> lines;
+  for ( int i = 0; i < N; ++i ) {
+    const int j = i + 1 == N ? 0 : i + 1;
+    const double ay = polygon( 1, i );
+    const double by = polygon( 1, j );
+    const bool swap = ay > by;
+    const double start_x = swap ? polygon( 0, j ) : polygon( 0, i );
+    const double start_y = swap ? by : ay;
+    Line &line = lines[i];
+    line.x_increment = std::abs( T( by - ay ) ) < 1E-4
+                           ? 0.0
+                           : double( polygon( 0, j ) - polygon( 0, i ) ) / ( by - ay );
+    // Compute x value at center of y-column
+    line.x = start_x + ( 0.5 - ( start_y - std::floor( start_y ) ) ) * line.x_increment;
+    line.start_y = start_y;
+    line.end_y = swap ? ay : by;
+  }
+  const Eigen::Index max_y =
+      std::min<Eigen::Index>( col_max, roundToIndex( polygon.row( 1 ).maxCoeff() ) );
+  // Sort lines by their y start. Insertion sort is the fastest for the few lines of a footprint.
+  for ( int i = 1; i < N; ++i ) {
+    const Line line = lines[i];
+    int k = i;
+    for ( ; k > 0 && lines[k - 1].start_y > line.start_y; --k ) lines[k] = lines[k - 1];
+    lines[k] = line;
+  }
+
+  std::array<Line, N> active_lines;
+  int active_count = 0;
+  int active_line_index = 0;
+  Eigen::Index y = std::max<Eigen::Index>( col_min, roundToIndex( lines[0].start_y ) );
+  for ( ; y < max_y; ++y ) {
+    const double y_cell_limit = double( y ) + 0.5;
+    // Remove lines that ended and advance the remaining lines to the current row.
+    int count = 0;
+    for ( int i = 0; i < active_count; ++i ) {
+      if ( active_lines[i].end_y < y_cell_limit )
+        continue;
+      active_lines[count] = active_lines[i];
+      active_lines[count].x += active_lines[count].x_increment;
+      ++count;
+    }
+    active_count = count;
+    // Determine new lines that started
+    for ( ; active_line_index < N && lines[active_line_index].start_y < y_cell_limit;
+          ++active_line_index ) {
+      Line &line = lines[active_line_index];
+      if ( line.end_y < y_cell_limit )
+        continue;
+      line.x += ( double( y ) - std::floor( line.start_y ) ) * line.x_increment;
+      active_lines[active_count++] = line;
+    }
+
+    // Restore the order by x
+    for ( int i = 1; i < active_count; ++i ) {
+      if ( active_lines[i - 1].x <= active_lines[i].x )
+        continue;
+      const Line line = active_lines[i];
+      int k = i;
+      for ( ; k > 0 && active_lines[k - 1].x > line.x; --k ) active_lines[k] = active_lines[k - 1];
+      active_lines[k] = line;
     }
-    std::sort( x_region_segments.begin(), x_region_segments.end() );
 
-    for ( std::size_t i = 0; i < x_region_segments.size() - 1; i += 2 ) {
-      Eigen::Index x_start = std::max<Eigen::Index>( row_min, x_region_segments[i] );
-      Eigen::Index x_end = std::min<Eigen::Index>( row_max, x_region_segments[i + 1] );
-      for ( Eigen::Index x = x_start; x < x_end; ++x ) { functor( x, y ); }
+    for ( int i = 0; i + 1 < active_count; i += 2 ) {
+      const Eigen::Index x_start =
+          std::max<Eigen::Index>( row_min, roundToIndex( active_lines[i].x ) );
+      const Eigen::Index x_end =
+          std::min<Eigen::Index>( row_max, roundToIndex( active_lines[i + 1].x ) );
+      if ( x_start < x_end && !invokeIteratorFunctor( functor, y, x_start, x_end ) )
+        return false;
     }
   }
+  return true;
 }
 } // namespace detail
 } // namespace hector_math
@@ -0,0 +1,194 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_POLYGON_OUTLINE_ITERATOR_H
+#define HECTOR_MATH_POLYGON_OUTLINE_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/types.h"
+#include <algorithm>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * Iterates over the outline of the given polygon and for each row y calls the given functor once
+ * per run of consecutive outline indexes [x_start, x_end).
+ * The outline consists of the cells that are visited by iteratePolygon, i.e., whose center is
+ * inside the polygon, and that have at least one 4-neighbor that is not, hence, the outline is
+ * 8-connected and its cells are the border of the polygon's cells.
+ * Each outline cell is visited exactly once. The runs are passed in ascending y and x.
+ * Apart from rasterizing the polygon, the work is linear in the perimeter instead of the area.
+ * Note: The polygon has to be in the index space, hence, if it is in map coordinates it might be
+ *   necessary to divide it by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * The limits do not change the outline, i.e., cells at the limits are only visited if they are
+ * on the outline of the polygon.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param polygon The polygon whose outline is iterated over.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iteratePolygonOutlineSpans( const Polygon<T> &polygon, Eigen::Index row_min,
+                                 Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                                 Functor functor );
+
+//! Overload of iteratePolygonOutlineSpans where row_min and col_min are set to 0 to allow for
+//! bounded iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iteratePolygonOutlineSpans( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols,
+                                 Functor functor )
+{
+  return iteratePolygonOutlineSpans( polygon, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iteratePolygonOutlineSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iteratePolygonOutlineSpans( const Polygon<T> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonOutlineSpans( polygon, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over the outline of the given polygon and for each index (x, y) calls the given functor.
+ * See iteratePolygonOutlineSpans for the definition of the outline.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param polygon The polygon whose outline is iterated over.
+ * @param functor The function that will be called for each index (x, y) on the outline.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iteratePolygonOutline( const Polygon<T> &polygon, Eigen::Index row_min, Eigen::Index row_max,
+                            Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+{
+  return iteratePolygonOutlineSpans(
+      polygon, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+//! Overload of iteratePolygonOutline where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iteratePolygonOutline( const Polygon<T> &polygon, Eigen::Index rows, Eigen::Index cols,
+                            Functor functor )
+{
+  return iteratePolygonOutline( polygon, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iteratePolygonOutline where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iteratePolygonOutline( const Polygon<T> &polygon, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iteratePolygonOutline( polygon, min, max, min, max, functor );
+}
+
+template<typename T, typename Functor>
+bool iteratePolygonOutlineSpans( const Polygon<T> &polygon, Eigen::Index row_min,
+                                 Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                                 Functor functor )
+{
+  struct Span {
+    Eigen::Index y;
+    Eigen::Index x_start;
+    Eigen::Index x_end;
+  };
+  // Whether a cell at the limits is on the outline depends on its neighbors outside of the limits,
+  // hence, the polygon is rasterized with limits that are extended by one cell.
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  std::vector<Span> spans;
+  iteratePolygonSpans( polygon, row_min == min ? min : row_min - 1,
+                       row_max == max ? max : row_max + 1, col_min == min ? min : col_min - 1,
+                       col_max == max ? max : col_max + 1,
+                       [&spans]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                         // Merge runs that touch after rounding
+                         if ( !spans.empty() && spans.back().y == y &&
+                              spans.back().x_end == x_start )
+                           spans.back().x_end = x_end;
+                         else
+                           spans.push_back( { y, x_start, x_end } );
+                       } );
+
+  // The cells of a run in row y that are covered in both row y - 1 and row y + 1 are inside the
+  // polygon except for the first and last cell of the run. The remaining cells are the outline.
+  std::vector<Span> interior;
+  std::size_t row_begin = 0;
+  std::size_t previous_begin = 0;
+  std::size_t previous_end = 0;
+  while ( row_begin < spans.size() ) {
+    const Eigen::Index y = spans[row_begin].y;
+    std::size_t row_end = row_begin + 1;
+    while ( row_end < spans.size() && spans[row_end].y == y ) ++row_end;
+    if ( y >= col_max )
+      break;
+    std::size_t next_end = row_end;
+    while ( next_end < spans.size() && spans[next_end].y == y + 1 ) ++next_end;
+    if ( previous_end == 0 || spans[previous_begin].y != y - 1 )
+      previous_begin = previous_end = row_begin; // No previous row
+
+    // Intersection of the runs of the previous and the next row, both are sorted and disjoint
+    interior.clear();
+    for ( std::size_t i = previous_begin, k = row_end; i < previous_end && k < next_end; ) {
+      const Eigen::Index start = std::max( spans[i].x_start, spans[k].x_start );
+      const Eigen::Index end = std::min( spans[i].x_end, spans[k].x_end );
+      if ( start < end )
+        interior.push_back( { y, start, end } );
+      if ( spans[i].x_end < spans[k].x_end )
+        ++i;
+      else
+        ++k;
+    }
+
+    if ( y >= col_min ) {
+      auto emit = [&]( Eigen::Index x_start, Eigen::Index x_end ) {
+        x_start = std::max( x_start, row_min );
+        x_end = std::min( x_end, row_max );
+        return x_start >= x_end || detail::invokeIteratorFunctor( functor, y, x_start, x_end );
+      };
+      std::size_t k = 0;
+      for ( std::size_t i = row_begin; i < row_end; ++i ) {
+        const Span &span = spans[i];
+        Eigen::Index x = span.x_start;
+        // The inner cells of the run that are in the interior are skipped
+        for ( ; k < interior.size(); ++k ) {
+          const Eigen::Index start = std::max( interior[k].x_start, span.x_start + 1 );
+          const Eigen::Index end = std::min( interior[k].x_end, span.x_end - 1 );
+          if ( start < end ) {
+            if ( !emit( x, start ) )
+              return false;
+            x = end;
+          }
+          if ( interior[k].x_end > span.x_end - 1 )
+            break; // The interval may also cover inner cells of the next run
+        }
+        if ( !emit( x, span.x_end ) )
+          return false;
+      }
+    }
+    previous_begin = row_begin;
+    previous_end = row_end;
+    row_begin = row_end;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_POLYGON_OUTLINE_ITERATOR_H
@@ -0,0 +1,173 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_POLYGON_RASTER_PLAN_H
+#define HECTOR_MATH_POLYGON_RASTER_PLAN_H
+
+#include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/types.h"
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * A precompiled rasterization of a polygon that can be replayed cheaply at arbitrary integer
+ * offsets and bounds.
+ * The polygon is rasterized once on construction using iteratePolygonSpans and the resulting
+ * runs are stored per row. Replaying the plan at the offset (x_offset, y_offset) visits the same
+ * cells as iteratePolygon would for the polygon translated by (x_offset, y_offset) but without
+ * rebuilding, sorting and stepping the edge table and without any allocations.
+ *
+ * Note: As for the iterators, the polygon has to be in the index space, hence, if it is in map
+ *   coordinates it might be necessary to divide it by the map resolution.
+ */
+class PolygonRasterPlan
+{
+public:
+  struct Span {
+    Eigen::Index x_start;
+    Eigen::Index x_end;
+  };
+
+  PolygonRasterPlan() = default;
+
+  template<typename T>
+  explicit PolygonRasterPlan( const Polygon<T> &polygon )
+  {
+    iteratePolygonSpans( polygon,
+                         [this]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                           if ( row_offsets_.empty() ) {
+                             y_start_ = y;
+                             row_offsets_.push_back( 0 );
+                           }
+                           // Close all rows up to and including the current one
+                           while ( y_start_ + static_cast<Eigen::Index>( row_offsets_.size() ) <=
+                                   y + 1 )
+                             row_offsets_.push_back( spans_.size() );
+                           spans_.push_back( { x_start, x_end } );
+                           row_offsets_.back() = spans_.size();
+                         } );
+  }
+
+  //! @return True if the rasterized polygon does not contain any cell.
+  bool empty() const { return spans_.empty(); }
+
+  //! @return The number of rows (distinct y indexes) spanned by the rasterized polygon.
+  Eigen::Index rows() const
+  {
+    return row_offsets_.empty() ? 0 : static_cast<Eigen::Index>( row_offsets_.size() ) - 1;
+  }
+
+  //! @return The first y index of the rasterized polygon without offset.
+  Eigen::Index yStart() const { return y_start_; }
+
+  //! @return The total number of runs stored in this plan.
+  std::size_t spanCount() const { return spans_.size(); }
+
+  /*!
+   * Replays the plan at the given offset and calls the functor for each run [x_start, x_end) in
+   * row y. See iteratePolygonSpans.
+   *
+   * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+   * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+   * @tparam Functor A function or lambda method with the signature:
+   *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+   * @param x_offset The offset that is added to the x indexes of the rasterized polygon.
+   * @param y_offset The offset that is added to the y indexes of the rasterized polygon.
+   * @return False if the iteration was stopped by the functor returning false, true otherwise.
+   */
+  template<typename Functor>
+  bool iterateSpans( Eigen::Index x_offset, Eigen::Index y_offset, Eigen::Index row_min,
+                     Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                     Functor functor ) const
+  {
+    if ( spans_.empty() )
+      return true;
+    const Eigen::Index y0 = y_start_ + y_offset;
+    const Eigen::Index row_count = rows();
+    // Careful to not overflow if the bounds are the numeric limits
+    const Eigen::Index first_row = col_min > y0 ? col_min - y0 : 0;
+    const Eigen::Index last_row = col_max < y0 + row_count ? col_max - y0 : row_count;
+    for ( Eigen::Index row = first_row; row < last_row; ++row ) {
+      const Eigen::Index y = y0 + row;
+      for ( std::size_t i = row_offsets_[row]; i < row_offsets_[row + 1]; ++i ) {
+        const Eigen::Index x_start =
+            std::max<Eigen::Index>( row_min, spans_[i].x_start + x_offset );
+        const Eigen::Index x_end = std::min<Eigen::Index>( row_max, spans_[i].x_end + x_offset );
+        if ( x_start < x_end && !detail::invokeIteratorFunctor( functor, y, x_start, x_end ) )
+          return false;
+      }
+    }
+    return true;
+  }
+
+  //! Overload of iterateSpans where row_min and col_min are set to 0 to allow for bounded
+  //! iteration of 2D matrices and arrays.
+  template<typename Functor>
+  bool iterateSpans( Eigen::Index x_offset, Eigen::Index y_offset, Eigen::Index rows,
+                     Eigen::Index cols, Functor functor ) const
+  {
+    return iterateSpans( x_offset, y_offset, 0, rows, 0, cols, functor );
+  }
+
+  //! Overload of iterateSpans where the indexes are not bounded.
+  template<typename Functor>
+  bool iterateSpans( Eigen::Index x_offset, Eigen::Index y_offset, Functor functor ) const
+  {
+    constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+    constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+    return iterateSpans( x_offset, y_offset, min, max, min, max, functor );
+  }
+
+  /*!
+   * Replays the plan at the given offset and calls the functor for each index (x, y) inside the
+   * translated polygon. See iteratePolygon.
+   *
+   * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+   * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+   * called with will be row_max - 1.
+   * @tparam Functor A function or lambda method with the signature:
+   *   void(Eigen::Index x, Eigen::Index y).
+   * @param x_offset The offset that is added to the x indexes of the rasterized polygon.
+   * @param y_offset The offset that is added to the y indexes of the rasterized polygon.
+   * @return False if the iteration was stopped by the functor returning false, true otherwise.
+   */
+  template<typename Functor>
+  bool iterate( Eigen::Index x_offset, Eigen::Index y_offset, Eigen::Index row_min,
+                Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                Functor functor ) const
+  {
+    return iterateSpans( x_offset, y_offset, row_min, row_max, col_min, col_max,
+                         [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                           return detail::iterateSpanCells( functor, y, x_start, x_end );
+                         } );
+  }
+
+  //! Overload of iterate where row_min and col_min are set to 0 to allow for bounded
+  //! iteration of 2D matrices and arrays.
+  template<typename Functor>
+  bool iterate( Eigen::Index x_offset, Eigen::Index y_offset, Eigen::Index rows, Eigen::Index cols,
+                Functor functor ) const
+  {
+    return iterate( x_offset, y_offset, 0, rows, 0, cols, functor );
+  }
+
+  //! Overload of iterate where the indexes are not bounded.
+  template<typename Functor>
+  bool iterate( Eigen::Index x_offset, Eigen::Index y_offset, Functor functor ) const
+  {
+    constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+    constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+    return iterate( x_offset, y_offset, min, max, min, max, functor );
+  }
+
+private:
+  //! The runs of all rows. The runs of row i are in [row_offsets_[i], row_offsets_[i+1]).
+  std::vector<Span> spans_;
+  std::vector<std::size_t> row_offsets_;
+  Eigen::Index y_start_ = 0;
+};
+} // namespace hector_math
+
+#endif // HECTOR_MATH_POLYGON_RASTER_PLAN_H
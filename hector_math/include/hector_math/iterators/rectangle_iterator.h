@@ -5,6 +5,7 @@
 #define HECTOR_MATH_RECTANGLE_ITERATOR_H
 
 #include "hector_math/containers/bounded_vector.h"
+#include "hector_math/iterators/iterator_functor.h"
 #include "hector_math/types.h"
 
 namespace hector_math
@@ -28,35 +29,206 @@ namespace hector_math
  * y).
  * @param polygon The polygon that is iterated over.
  * @param functor The function that will be called for each index (x, y) inside the polygon.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
  */
 template<typename T, typename Functor>
-void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+bool iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
                        Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
                        Eigen::Index col_max, Functor functor );
 
 //! Overload of iterateRectangle where row_min and col_min are set to 0 to allow for bounded
 //! iteration of 2D matrices and arrays.
 template<typename T, typename Functor>
-void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+bool iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
                        Eigen::Index rows, Eigen::Index cols, Functor functor )
 {
-  iterateRectangle( a, b, c, 0, rows, 0, cols, functor );
+  return iterateRectangle( a, b, c, 0, rows, 0, cols, functor );
 }
 
 //! Overload of iterateRectangle where the indexes are not bounded.
 template<typename T, typename Functor>
-void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c, Functor functor )
+bool iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c, Functor functor )
 {
   constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
   constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
-  iterateRectangle( a, b, c, min, max, min, max, functor );
+  return iterateRectangle( a, b, c, min, max, min, max, functor );
 }
 
+/*!
+ * Iterates over all indexes that lie in the rectangle formed by the three points a, b and c - where
+ * ab, and ac form adjacent edges of the rectangle - and for each row y calls the given functor once
+ * with the run of indexes [x_start, x_end) that lie in the rectangle.
+ * The same cells as in iterateRectangle are visited, but instead of one call per cell, the functor
+ * receives the whole run which allows processing the corresponding segment of a column-major map,
+ * e.g., using <tt>map.col( y ).segment( x_start, x_end - x_start )</tt>.
+ * Empty runs are not passed to the functor.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateRectangleSpans( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                            Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                            Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateRectangleSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateRectangleSpans( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                            Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateRectangleSpans( a, b, c, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateRectangleSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateRectangleSpans( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                            Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateRectangleSpans( a, b, c, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the rectangle formed by the three points a, b and c - where
+ * ab, and ac form adjacent edges of the rectangle - and for each row y calls the given functor once
+ * with the run of indexes [x_start, x_end) that lie in the rectangle.
+ * Same as iterateRectangleSpans but the x values of the edges are stepped from row to row as 32.32
+ * fixed-point integers instead of doubles. See iteratePolygonSpansFixedPoint.
+ * Note: The x values of the rectangle have to be in the range (-2^31, 2^31).
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateRectangleSpansFixedPoint( const Vector2<T> &a, const Vector2<T> &b,
+                                      const Vector2<T> &c, Eigen::Index row_min,
+                                      Eigen::Index row_max, Eigen::Index col_min,
+                                      Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateRectangleSpansFixedPoint where row_min and col_min are set to 0 to allow for
+//! bounded iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateRectangleSpansFixedPoint( const Vector2<T> &a, const Vector2<T> &b,
+                                      const Vector2<T> &c, Eigen::Index rows, Eigen::Index cols,
+                                      Functor functor )
+{
+  return iterateRectangleSpansFixedPoint( a, b, c, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateRectangleSpansFixedPoint where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateRectangleSpansFixedPoint( const Vector2<T> &a, const Vector2<T> &b,
+                                      const Vector2<T> &c, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateRectangleSpansFixedPoint( a, b, c, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the rectangle formed by the three points a, b and c - where
+ * ab, and ac form adjacent edges of the rectangle - and for each index (x, y) calls the given
+ * functor. See iterateRectangleSpansFixedPoint.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param functor The function that will be called for each index (x, y) inside the rectangle.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateRectangleFixedPoint( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                                 Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                                 Eigen::Index col_max, Functor functor )
+{
+  return iterateRectangleSpansFixedPoint(
+      a, b, c, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+//! Overload of iterateRectangleFixedPoint where row_min and col_min are set to 0 to allow for
+//! bounded iteration of 2D matrices and arrays.
 template<typename T, typename Functor>
-void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+bool iterateRectangleFixedPoint( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                                 Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateRectangleFixedPoint( a, b, c, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateRectangleFixedPoint where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateRectangleFixedPoint( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                                 Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateRectangleFixedPoint( a, b, c, min, max, min, max, functor );
+}
+
+namespace detail
+{
+template<typename Stepping, typename T, typename Functor>
+bool iterateSteppedRectangleSpans( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                                   Eigen::Index row_min, Eigen::Index row_max,
+                                   Eigen::Index col_min, Eigen::Index col_max, Functor functor );
+} // namespace detail
+
+template<typename T, typename Functor>
+bool iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
                        Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
                        Eigen::Index col_max, Functor functor )
 {
+  return iterateRectangleSpans(
+      a, b, c, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+template<typename T, typename Functor>
+bool iterateRectangleSpans( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                            Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                            Eigen::Index col_max, Functor functor )
+{
+  return detail::iterateSteppedRectangleSpans<detail::FloatingPointStepping>(
+      a, b, c, row_min, row_max, col_min, col_max, functor );
+}
+
+template<typename T, typename Functor>
+bool iterateRectangleSpansFixedPoint( const Vector2<T> &a, const Vector2<T> &b,
+                                      const Vector2<T> &c, Eigen::Index row_min,
+                                      Eigen::Index row_max, Eigen::Index col_min,
+                                      Eigen::Index col_max, Functor functor )
+{
+  return detail::iterateSteppedRectangleSpans<detail::FixedPointStepping>(
+      a, b, c, row_min, row_max, col_min, col_max, functor );
+}
+
+namespace detail
+{
+template<typename Stepping, typename T, typename Functor>
+bool iterateSteppedRectangleSpans( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T> &c,
+                                   Eigen::Index row_min, Eigen::Index row_max,
+                                   Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+{
+  using Value = typename Stepping::Value;
   const auto &d = b + c - a;
 
   std::array<Vector2<T>, 4> points = { a, b, d, c };
@@ -87,19 +259,21 @@ void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T
     {
       if ( std::abs( end.y() - start.y() ) < 1E-4 ) {
         x_increment = 0;
-        x = double( left ? std::min( start.x(), end.x() ) : std::max( start.x(), end.x() ) );
+        x = Stepping::fromDouble(
+            left ? std::min( start.x(), end.x() ) : std::max( start.x(), end.x() ) );
         return;
       }
-      x_increment = double( end.x() - start.x() ) / double( end.y() - start.y() );
+      const double increment = double( end.x() - start.x() ) / double( end.y() - start.y() );
 
       // Compute x value at center of y-column
       const double diff_start_y =
           y - std::floor( start.y() ) + 0.5 - ( start.y() - std::floor( start.y() ) );
-      x = start.x() + diff_start_y * x_increment;
+      x = Stepping::fromDouble( start.x() + diff_start_y * increment );
+      x_increment = Stepping::fromDouble( increment );
     }
 
-    double x;
-    double x_increment;
+    Value x;
+    Value x_increment;
   };
 
   Eigen::Index y = std::max<Eigen::Index>( col_min, std::round( lowest.y() ) );
@@ -110,11 +284,14 @@ void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T
   Eigen::Index next_y = std::min( left_switch, right_switch );
   // Loop until next corner
   for ( ; y < next_y; ++y ) {
-    Eigen::Index x = std::max<Eigen::Index>( row_min, std::round( left_line.x ) );
-    const Eigen::Index x_end = std::min<Eigen::Index>( row_max, std::round( right_line.x ) );
+    const Eigen::Index x_start =
+        std::max<Eigen::Index>( row_min, Stepping::toIndex( left_line.x ) );
+    const Eigen::Index x_end =
+        std::min<Eigen::Index>( row_max, Stepping::toIndex( right_line.x ) );
     left_line.x += left_line.x_increment;
     right_line.x += right_line.x_increment;
-    for ( ; x < x_end; ++x ) { functor( x, y ); }
+    if ( x_start < x_end && !detail::invokeIteratorFunctor( functor, y, x_start, x_end ) )
+      return false;
   }
 
   // Either left or right switched, if both, the for loop will have 0 iterations
@@ -128,11 +305,14 @@ void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T
 
   // Loop until next corner
   for ( ; y < next_y; ++y ) {
-    Eigen::Index x = std::max<Eigen::Index>( row_min, std::round( left_line.x ) );
-    const Eigen::Index x_end = std::min<Eigen::Index>( row_max, std::round( right_line.x ) );
+    const Eigen::Index x_start =
+        std::max<Eigen::Index>( row_min, Stepping::toIndex( left_line.x ) );
+    const Eigen::Index x_end =
+        std::min<Eigen::Index>( row_max, Stepping::toIndex( right_line.x ) );
     left_line.x += left_line.x_increment;
     right_line.x += right_line.x_increment;
-    for ( ; x < x_end; ++x ) { functor( x, y ); }
+    if ( x_start < x_end && !detail::invokeIteratorFunctor( functor, y, x_start, x_end ) )
+      return false;
   }
   // Final switch, inverted order since if both switch at the same y, now right takes precedence
   if ( y == right_switch ) {
@@ -143,12 +323,17 @@ void iterateRectangle( const Vector2<T> &a, const Vector2<T> &b, const Vector2<T
 
   // Loop until end
   for ( ; y < max_y; ++y ) {
-    Eigen::Index x = std::max<Eigen::Index>( row_min, std::round( left_line.x ) );
-    const Eigen::Index x_end = std::min<Eigen::Index>( row_max, std::round( right_line.x ) );
+    const Eigen::Index x_start =
+        std::max<Eigen::Index>( row_min, Stepping::toIndex( left_line.x ) );
+    const Eigen::Index x_end =
+        std::min<Eigen::Index>( row_max, Stepping::toIndex( right_line.x ) );
     left_line.x += left_line.x_increment;
     right_line.x += right_line.x_increment;
-    for ( ; x < x_end; ++x ) { functor( x, y ); }
+    if ( x_start < x_end && !detail::invokeIteratorFunctor( functor, y, x_start, x_end ) )
+      return false;
   }
+  return true;
 }
+} // namespace detail
 } // namespace hector_math
 #endif // HECTOR_MATH_RECTANGLE_ITERATOR_H
@@ -0,0 +1,206 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_SECTOR_ITERATOR_H
+#define HECTOR_MATH_SECTOR_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/types.h"
+
+namespace hector_math
+{
+/*!
+ * Iterates over all indexes that lie in the given circular sector, e.g., the field of view of a sensor, and for
+ * each index (x, y) calls the given functor.
+ * This method will iterate all cells where the center of the cell (x+0.5, y+0.5) is inside the circle with the given
+ * radius and its direction from the center is at most opening_angle / 2 away from the given direction.
+ * Note: The sector has to be in the index space, hence, if it is in map coordinates it might be necessary to divide
+ *   it by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where row/col_min is included
+ * but row/col_max is excluded, i.e., the largest x index functor may be called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param center The center of the circle, i.e., the apex of the sector.
+ * @param radius The radius of the sector.
+ * @param direction The direction of the bisector of the sector in radians.
+ * @param opening_angle The angle between the two straight edges of the sector in radians. If it is at least 2 pi,
+ *   the sector is the full circle.
+ * @param functor The function that will be called for each index (x, y) inside the sector.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateSector( const Vector2<T> &center, double radius, double direction, double opening_angle,
+                    Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                    Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateSector where row_min and col_min are set to 0 to allow for bounded iteration
+//! of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateSector( const Vector2<T> &center, double radius, double direction, double opening_angle,
+                    Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateSector( center, radius, direction, opening_angle, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateSector where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateSector( const Vector2<T> &center, double radius, double direction, double opening_angle,
+                    Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateSector( center, radius, direction, opening_angle, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the given circular sector and for each row y calls the
+ * given functor once for each of the up to two runs of indexes [x_start, x_end) that lie in the
+ * sector. Two runs in one row are only possible if the opening angle is larger than pi.
+ * The same cells as in iterateSector are visited. The runs of each row are computed in closed form
+ * and passed in ascending x. Empty runs are not passed to the functor.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param center The center of the circle, i.e., the apex of the sector.
+ * @param radius The radius of the sector.
+ * @param direction The direction of the bisector of the sector in radians.
+ * @param opening_angle The angle between the two straight edges of the sector in radians.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateSectorSpans( const Vector2<T> &center, double radius, double direction,
+                         double opening_angle, Eigen::Index row_min, Eigen::Index row_max,
+                         Eigen::Index col_min, Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateSectorSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateSectorSpans( const Vector2<T> &center, double radius, double direction,
+                         double opening_angle, Eigen::Index rows, Eigen::Index cols,
+                         Functor functor )
+{
+  return iterateSectorSpans( center, radius, direction, opening_angle, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateSectorSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateSectorSpans( const Vector2<T> &center, double radius, double direction,
+                         double opening_angle, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateSectorSpans( center, radius, direction, opening_angle, min, max, min, max,
+                             functor );
+}
+
+template<typename T, typename Functor>
+bool iterateSector( const Vector2<T> &center, double radius, double direction, double opening_angle,
+                    Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                    Eigen::Index col_max, Functor functor )
+{
+  return iterateSectorSpans(
+      center, radius, direction, opening_angle, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+namespace detail
+{
+/*!
+ * Restricts the interval [lo, hi] of dx in the row at delta_y to the half-plane left of the ray
+ * from the center in the given direction, i.e., cross(direction, (dx, delta_y)) >= 0.
+ * Use a negated direction for the half-plane to the right.
+ * @return False if the interval is empty.
+ */
+inline bool clipToHalfPlane( double dir_x, double dir_y, double delta_y, double &lo, double &hi )
+{
+  // dir_x * delta_y - dir_y * dx >= 0
+  if ( dir_y > 0 )
+    hi = std::min( hi, dir_x * delta_y / dir_y );
+  else if ( dir_y < 0 )
+    lo = std::max( lo, dir_x * delta_y / dir_y );
+  else if ( dir_x * delta_y < 0 )
+    return false;
+  return lo < hi;
+}
+} // namespace detail
+
+template<typename T, typename Functor>
+bool iterateSectorSpans( const Vector2<T> &center, double radius, double direction,
+                         double opening_angle, Eigen::Index row_min, Eigen::Index row_max,
+                         Eigen::Index col_min, Eigen::Index col_max, Functor functor )
+{
+  if ( opening_angle <= 0 )
+    return true;
+  const bool full_circle = opening_angle >= 2 * M_PI;
+  // The sector is the intersection (opening_angle <= pi) or the union (opening_angle > pi) of the
+  // half-planes left of the start edge and right of the end edge.
+  const bool convex = opening_angle <= M_PI;
+  const double start_x = std::cos( direction - opening_angle / 2 );
+  const double start_y = std::sin( direction - opening_angle / 2 );
+  const double end_x = std::cos( direction + opening_angle / 2 );
+  const double end_y = std::sin( direction + opening_angle / 2 );
+
+  const double cx = double( center.x() );
+  const Eigen::Index min_y =
+      std::max<Eigen::Index>( col_min, std::round( double( center.y() ) - radius ) );
+  const Eigen::Index max_y =
+      std::min<Eigen::Index>( col_max, std::round( double( center.y() ) + radius ) );
+  const double radius_squared = radius * radius;
+  const auto emit = [&]( Eigen::Index y, double lo, double hi ) {
+    const Eigen::Index x_start = std::max<Eigen::Index>( row_min, std::round( cx + lo ) );
+    const Eigen::Index x_end = std::min<Eigen::Index>( row_max, std::round( cx + hi ) );
+    return x_start >= x_end || detail::invokeIteratorFunctor( functor, y, x_start, x_end );
+  };
+  for ( Eigen::Index y = min_y; y < max_y; ++y ) {
+    const double delta_y = double( y ) + 0.5 - double( center.y() );
+    const double width = std::sqrt( radius_squared - delta_y * delta_y );
+    if ( full_circle ) {
+      if ( !emit( y, -width, width ) )
+        return false;
+      continue;
+    }
+    double start_lo = -width, start_hi = width;
+    const bool in_start = detail::clipToHalfPlane( start_x, start_y, delta_y, start_lo, start_hi );
+    if ( convex ) {
+      if ( in_start && detail::clipToHalfPlane( -end_x, -end_y, delta_y, start_lo, start_hi ) &&
+           !emit( y, start_lo, start_hi ) )
+        return false;
+      continue;
+    }
+    double end_lo = -width, end_hi = width;
+    const bool in_end = detail::clipToHalfPlane( -end_x, -end_y, delta_y, end_lo, end_hi );
+    if ( !in_start && !in_end )
+      continue;
+    if ( !in_end || ( in_start && std::max( start_lo, end_lo ) <= std::min( start_hi, end_hi ) ) ) {
+      // One run: either only one of the half-planes is non-empty or they overlap
+      const double lo = in_end ? std::min( start_lo, end_lo ) : start_lo;
+      const double hi = in_end ? std::max( start_hi, end_hi ) : start_hi;
+      if ( !emit( y, lo, hi ) )
+        return false;
+      continue;
+    }
+    if ( !in_start ) {
+      if ( !emit( y, end_lo, end_hi ) )
+        return false;
+      continue;
+    }
+    // Two disjoint runs, passed in ascending x
+    if ( start_lo > end_lo ) {
+      std::swap( start_lo, end_lo );
+      std::swap( start_hi, end_hi );
+    }
+    if ( !emit( y, start_lo, start_hi ) || !emit( y, end_lo, end_hi ) )
+      return false;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_SECTOR_ITERATOR_H
@@ -0,0 +1,127 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_SWEPT_POLYGON_ITERATOR_H
+#define HECTOR_MATH_SWEPT_POLYGON_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/iterators/multi_polygon_iterator.h"
+#include "hector_math/types.h"
+
+namespace hector_math
+{
+
+/*!
+ * Iterates over all indexes that lie in the area swept by the given polygon, e.g., a robot
+ * footprint, when it is placed at each of the given poses, e.g., the sampled poses of a motion
+ * primitive. For each row y the given functor is called once per run of consecutive indexes
+ * [x_start, x_end) in the union of the placed polygons.
+ * A cell is in the union if its center lies in the polygon transformed by at least one of the
+ * poses, i.e., if it would be visited by iteratePolygon for that pose. In contrast to iterating
+ * each pose separately, every cell is visited exactly once and touching runs are merged.
+ * All placed polygons are rasterized in a single scanline pass with the nonzero fill rule (see
+ * iterateMultiPolygonSpans), hence, the runs are passed in ascending y and x.
+ * Note: The polygon must not be self-intersecting.
+ * Note: The polygon and the translations of the poses have to be in the index space, hence, if
+ *   they are in map coordinates it might be necessary to divide them by the map resolution.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., x_end will be at most row_max.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param polygon The polygon in its local frame.
+ * @param poses The poses at which the polygon is placed.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateSweptPolygonSpans( const Polygon<T> &polygon, const Pose2DList<T> &poses,
+                               Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                               Eigen::Index col_max, Functor functor );
+
+//! Overload of iterateSweptPolygonSpans where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateSweptPolygonSpans( const Polygon<T> &polygon, const Pose2DList<T> &poses,
+                               Eigen::Index rows, Eigen::Index cols, Functor functor )
+{
+  return iterateSweptPolygonSpans( polygon, poses, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateSweptPolygonSpans where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateSweptPolygonSpans( const Polygon<T> &polygon, const Pose2DList<T> &poses,
+                               Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateSweptPolygonSpans( polygon, poses, min, max, min, max, functor );
+}
+
+/*!
+ * Iterates over all indexes that lie in the area swept by the given polygon when it is placed at
+ * each of the given poses and for each index (x, y) calls the given functor exactly once.
+ * See iterateSweptPolygonSpans.
+ *
+ * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max) where
+ * row/col_min is included but row/col_max is excluded, i.e., the largest x index functor may be
+ * called with will be row_max - 1.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param polygon The polygon in its local frame.
+ * @param poses The poses at which the polygon is placed.
+ * @param functor The function that will be called for each index (x, y) in the swept area.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<typename T, typename Functor>
+bool iterateSweptPolygon( const Polygon<T> &polygon, const Pose2DList<T> &poses,
+                          Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                          Eigen::Index col_max, Functor functor )
+{
+  return iterateSweptPolygonSpans(
+      polygon, poses, row_min, row_max, col_min, col_max,
+      [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+//! Overload of iterateSweptPolygon where row_min and col_min are set to 0 to allow for bounded
+//! iteration of 2D matrices and arrays.
+template<typename T, typename Functor>
+bool iterateSweptPolygon( const Polygon<T> &polygon, const Pose2DList<T> &poses, Eigen::Index rows,
+                          Eigen::Index cols, Functor functor )
+{
+  return iterateSweptPolygon( polygon, poses, 0, rows, 0, cols, functor );
+}
+
+//! Overload of iterateSweptPolygon where the indexes are not bounded.
+template<typename T, typename Functor>
+bool iterateSweptPolygon( const Polygon<T> &polygon, const Pose2DList<T> &poses, Functor functor )
+{
+  constexpr Eigen::Index min = std::numeric_limits<Eigen::Index>::min();
+  constexpr Eigen::Index max = std::numeric_limits<Eigen::Index>::max();
+  return iterateSweptPolygon( polygon, poses, min, max, min, max, functor );
+}
+
+template<typename T, typename Functor>
+bool iterateSweptPolygonSpans( const Polygon<T> &polygon, const Pose2DList<T> &poses,
+                               Eigen::Index row_min, Eigen::Index row_max, Eigen::Index col_min,
+                               Eigen::Index col_max, Functor functor )
+{
+  if ( polygon.cols() < 3 )
+    return true;
+  // Rotations preserve the orientation of the polygon, hence, all placed polygons have the same
+  // orientation and the nonzero fill of all of them is their union.
+  PolygonList<T> rings( poses.size() );
+  for ( std::size_t i = 0; i < poses.size(); ++i ) {
+    rings[i].resize( 2, polygon.cols() );
+    rings[i].matrix().noalias() = poses[i].rotation().toRotationMatrix() * polygon.matrix();
+    rings[i].colwise() += poses[i].translation().array();
+  }
+  return iterateMultiPolygonSpans( rings, FillRule::NonZero, row_min, row_max, col_min, col_max,
+                                   functor );
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_SWEPT_POLYGON_ITERATOR_H
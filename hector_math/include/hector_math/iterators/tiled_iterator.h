@@ -0,0 +1,146 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_TILED_ITERATOR_H
+#define HECTOR_MATH_TILED_ITERATOR_H
+
+#include "hector_math/iterators/iterator_functor.h"
+#include "hector_math/types.h"
+#include <algorithm>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * Reorders the runs of a span iterator, e.g., iteratePolygonSpans, into tile order.
+ * The index space is divided into square tiles of TileSize x TileSize indexes and the functor is
+ * called for the runs of one tile before the next tile is visited.
+ * The tiles are visited in bands of TileSize rows y with ascending y, within a band with ascending
+ * x, and inside a tile the rows are visited with ascending y. Runs are split at the tile borders.
+ * Tiles that contain no index of the region are skipped.
+ *
+ * For large regions of a large map, this keeps the accessed memory within a few pages at a time.
+ * With a TiledGridMap of the same TileSize, the cells of a tile are contiguous in memory, hence,
+ * every run passed to the functor is a contiguous block of memory.
+ *
+ * Example:
+ * @code
+ * iterateTiledSpans( [&]( auto &&f ) { return iteratePolygonSpans( polygon, rows, cols, f ); },
+ *                    [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) { ... } );
+ * @endcode
+ * @tparam TileSize The number of indexes per side of a tile. Has to be a power of two.
+ * @tparam SpanIterator A function or lambda method that is called with a functor with the signature
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end) and passes the runs of the
+ *   region to it. The runs of a row must not overlap.
+ * @tparam Functor A function or lambda method with the signature:
+ *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+ * @param iterate_spans The span iterator that produces the region.
+ * @param functor The function that will be called for each run [x_start, x_end) in row y.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<int TileSize = 64, typename SpanIterator, typename Functor>
+bool iterateTiledSpans( SpanIterator iterate_spans, Functor functor );
+
+/*!
+ * Reorders the indexes of a span iterator, e.g., iteratePolygonSpans, into tile order and for each
+ * index (x, y) calls the given functor. See iterateTiledSpans for the order.
+ * @tparam TileSize The number of indexes per side of a tile. Has to be a power of two.
+ * @tparam SpanIterator See iterateTiledSpans.
+ * @tparam Functor A function or lambda method with the signature: void(Eigen::Index x, Eigen::Index y).
+ * @param iterate_spans The span iterator that produces the region.
+ * @param functor The function that will be called for each index (x, y) of the region.
+ *   If the functor returns bool, the iteration stops as soon as it returns false.
+ * @return False if the iteration was stopped by the functor, true otherwise.
+ */
+template<int TileSize = 64, typename SpanIterator, typename Functor>
+bool iterateTiled( SpanIterator iterate_spans, Functor functor )
+{
+  return iterateTiledSpans<TileSize>(
+      iterate_spans, [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        return detail::iterateSpanCells( functor, y, x_start, x_end );
+      } );
+}
+
+namespace detail
+{
+//! Index of the tile containing the given index, i.e., floor(index / TileSize).
+template<int TileSize>
+inline Eigen::Index tileIndex( Eigen::Index index )
+{
+  return index >= 0 ? index / TileSize : -( ( -( index + 1 ) ) / TileSize ) - 1;
+}
+} // namespace detail
+
+template<int TileSize, typename SpanIterator, typename Functor>
+bool iterateTiledSpans( SpanIterator iterate_spans, Functor functor )
+{
+  static_assert( TileSize > 0 && ( TileSize & ( TileSize - 1 ) ) == 0,
+                 "TileSize has to be a power of two!" );
+  struct Span {
+    Eigen::Index y;
+    Eigen::Index x_start;
+    Eigen::Index x_end;
+  };
+  std::vector<Span> spans;
+  iterate_spans( [&spans]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+    if ( x_start < x_end )
+      spans.push_back( { y, x_start, x_end } );
+  } );
+  const auto span_less = []( const Span &a, const Span &b ) {
+    return a.y < b.y || ( a.y == b.y && a.x_start < b.x_start );
+  };
+  if ( !std::is_sorted( spans.begin(), spans.end(), span_less ) )
+    std::sort( spans.begin(), spans.end(), span_less );
+
+  // For each row of the current band, the next run that has not been passed completely and the end
+  // of the row's runs
+  std::vector<std::size_t> cursors;
+  std::vector<std::size_t> row_ends;
+  std::size_t band_begin = 0;
+  while ( band_begin < spans.size() ) {
+    const Eigen::Index band = detail::tileIndex<TileSize>( spans[band_begin].y );
+    cursors.clear();
+    row_ends.clear();
+    Eigen::Index tile_x = std::numeric_limits<Eigen::Index>::max();
+    std::size_t band_end = band_begin;
+    while ( band_end < spans.size() && detail::tileIndex<TileSize>( spans[band_end].y ) == band ) {
+      const Eigen::Index y = spans[band_end].y;
+      cursors.push_back( band_end );
+      tile_x = std::min( tile_x, detail::tileIndex<TileSize>( spans[band_end].x_start ) );
+      while ( band_end < spans.size() && spans[band_end].y == y ) ++band_end;
+      row_ends.push_back( band_end );
+    }
+
+    while ( true ) {
+      const Eigen::Index tile_start = tile_x * TileSize;
+      const Eigen::Index tile_end = tile_start + TileSize;
+      Eigen::Index next_tile_x = std::numeric_limits<Eigen::Index>::max();
+      for ( std::size_t row = 0; row < cursors.size(); ++row ) {
+        std::size_t i = cursors[row];
+        for ( ; i < row_ends[row] && spans[i].x_start < tile_end; ++i ) {
+          const Span &span = spans[i];
+          const Eigen::Index x_start = std::max( span.x_start, tile_start );
+          const Eigen::Index x_end = std::min( span.x_end, tile_end );
+          if ( !detail::invokeIteratorFunctor( functor, span.y, x_start, x_end ) )
+            return false;
+          if ( span.x_end > tile_end )
+            break; // The remainder of the run is in the next tiles
+        }
+        cursors[row] = i;
+        if ( i < row_ends[row] )
+          next_tile_x = std::min( next_tile_x, detail::tileIndex<TileSize>(
+                                                   std::max( spans[i].x_start, tile_end ) ) );
+      }
+      if ( next_tile_x == std::numeric_limits<Eigen::Index>::max() )
+        break;
+      tile_x = next_tile_x;
+    }
+    band_begin = band_end;
+  }
+  return true;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_TILED_ITERATOR_H
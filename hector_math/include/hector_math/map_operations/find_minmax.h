@@ -5,6 +5,7 @@
 #define HECTOR_MATH_FIND_MINMAX_H
 
 #include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/map_operations/minmax_kernels.h"
 #include "hector_math/types.h"
 
 namespace hector_math
@@ -13,12 +14,14 @@ namespace hector_math
 /*!
  * Finds the minimum value in the map and the location in the form of row and col index.
  * This method is robust against NaN values in the map.
+ * If the minimum occurs multiple times, the first occurrence in memory order is returned.
+ * For maps with contiguous columns, the search is vectorized, see minmax_kernels.h.
  *
  * @tparam Scalar The floating point type that is used.
  * @param map The GridMap in which we are looking for the minimum value.
- * @param row The row index of the minimum.
- * @param col The column index of the minimum.
- * @return The minimum value inside the map.
+ * @param row The row index of the minimum. Unchanged if the map has no non-NaN value.
+ * @param col The column index of the minimum. Unchanged if the map has no non-NaN value.
+ * @return The minimum value inside the map or NaN if the map has no non-NaN value.
  */
 template<typename EigenType>
 typename EigenType::Scalar findMinimumAndIndex( const EigenType &map, Eigen::Index &row,
@@ -27,12 +30,14 @@ typename EigenType::Scalar findMinimumAndIndex( const EigenType &map, Eigen::Ind
 /*!
  * Finds the maximum value in the map and the location in the form of row and col index.
  * This method is robust against NaN values in the map.
+ * If the maximum occurs multiple times, the first occurrence in memory order is returned.
+ * For maps with contiguous columns, the search is vectorized, see minmax_kernels.h.
  *
  * @tparam Scalar The floating point type that is used.
  * @param map The GridMap in which we are looking for the maximum value.
- * @param row The row index of the maximum.
- * @param col The column index of the maximum.
- * @return The maximum value inside the map.
+ * @param row The row index of the maximum. Unchanged if the map has no non-NaN value.
+ * @param col The column index of the maximum. Unchanged if the map has no non-NaN value.
+ * @return The maximum value inside the map or NaN if the map has no non-NaN value.
  */
 template<typename EigenType>
 typename EigenType::Scalar findMaximumAndIndex( const EigenType &map, Eigen::Index &row,
@@ -64,69 +69,74 @@ Scalar findMaximum( const Eigen::Ref<const GridMap<Scalar>> &map, const Polygon<
 
 namespace impl
 {
-template<typename Scalar, typename std::enable_if<std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
-constexpr Scalar initialMinimum()
-{
-  return std::numeric_limits<Scalar>::quiet_NaN();
-}
-
-template<typename Scalar,
-         typename std::enable_if<!std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
-constexpr Scalar initialMinimum()
-{
-  return std::numeric_limits<Scalar>::max();
-}
-
-template<typename Scalar, typename std::enable_if<std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
-constexpr Scalar initialMaximum()
-{
-  return std::numeric_limits<Scalar>::quiet_NaN();
-}
-
-template<typename Scalar,
-         typename std::enable_if<!std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
-constexpr Scalar initialMaximum()
-{
-  return std::numeric_limits<Scalar>::min();
-}
-} // namespace impl
-
-template<typename EigenType>
-typename EigenType::Scalar findMinimumAndIndex( const EigenType &map, Eigen::Index &row,
-                                                Eigen::Index &col )
+/*!
+ * Finds the first minimum (or maximum) of the map in column-major order.
+ * If the columns of the map are contiguous in memory, the vectorized kernels are used.
+ * @return False if there is no value in the map that is not NaN, row and col are unchanged then.
+ */
+template<bool Maximum, typename EigenType>
+bool findExtremumAndIndex( const EigenType &map, Eigen::Index &row, Eigen::Index &col )
 {
   using Scalar = typename EigenType::Scalar;
-  Scalar minimum = impl::initialMinimum<Scalar>();
+  constexpr bool direct_access = ( EigenType::Flags & Eigen::DirectAccessBit ) != 0;
+  if constexpr ( direct_access && !EigenType::IsRowMajor ) {
+    if ( map.innerStride() == 1 ) {
+      if ( map.outerStride() == map.rows() || map.cols() == 1 ) {
+        // All values are contiguous
+        const Eigen::Index index = findExtremumIndex<Maximum>( map.data(), map.size() );
+        if ( index == -1 )
+          return false;
+        row = index % map.rows();
+        col = index / map.rows();
+        return true;
+      }
+      const Scalar *best = nullptr;
+      for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+        const Scalar *column = map.data() + y * map.outerStride();
+        const Eigen::Index index = findExtremumIndex<Maximum>( column, map.rows() );
+        if ( index == -1 ||
+             ( best != nullptr && !isBetterExtremum<Maximum>( column[index], *best ) ) )
+          continue;
+        best = column + index;
+        row = index;
+        col = y;
+      }
+      return best != nullptr;
+    }
+  }
+  Scalar best = Maximum ? initialMaximum<Scalar>() : initialMinimum<Scalar>();
+  bool found = false;
   for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
     for ( Eigen::Index x = 0; x < map.rows(); ++x ) {
       const Scalar &val = map( x, y );
-      if ( std::isnan( val ) || val >= minimum )
-        continue; // Will be false for NaN
-      minimum = val;
+      if ( !isBetterExtremum<Maximum>( val, best ) )
+        continue;
+      best = val;
       row = x;
       col = y;
+      found = true;
     }
   }
-  return minimum;
+  return found;
+}
+} // namespace impl
+
+template<typename EigenType>
+typename EigenType::Scalar findMinimumAndIndex( const EigenType &map, Eigen::Index &row,
+                                                Eigen::Index &col )
+{
+  if ( !impl::findExtremumAndIndex<false>( map, row, col ) )
+    return impl::initialMinimum<typename EigenType::Scalar>();
+  return map( row, col );
 }
 
 template<typename EigenType>
 typename EigenType::Scalar findMaximumAndIndex( const EigenType &map, Eigen::Index &row,
                                                 Eigen::Index &col )
 {
-  using Scalar = typename EigenType::Scalar;
-  Scalar maximum = impl::initialMaximum<Scalar>();
-  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
-    for ( Eigen::Index x = 0; x < map.rows(); ++x ) {
-      const Scalar &val = map( x, y );
-      if ( std::isnan( val ) || val <= maximum )
-        continue; // Will be false for NaN
-      maximum = val;
-      row = x;
-      col = y;
-    }
-  }
-  return maximum;
+  if ( !impl::findExtremumAndIndex<true>( map, row, col ) )
+    return impl::initialMaximum<typename EigenType::Scalar>();
+  return map( row, col );
 }
 
 template<typename Scalar>
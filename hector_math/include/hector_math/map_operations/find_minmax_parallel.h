@@ -0,0 +1,145 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_FIND_MINMAX_PARALLEL_H
+#define HECTOR_MATH_FIND_MINMAX_PARALLEL_H
+
+#include "hector_math/map_operations/find_minmax.h"
+#include "hector_math/parallel/thread_pool.h"
+#include "hector_math/types.h"
+#include <exception>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * Parallel variant of findMinimumAndIndex which splits the map into blocks of consecutive columns
+ * that are searched concurrently on the given thread pool. Since the map is column-major, each
+ * block is contiguous in memory for dense maps.
+ * The block results are merged in the order of the blocks, hence, the result is the same as for
+ * findMinimumAndIndex including which of multiple equal minima is returned.
+ * Small maps are searched by the calling thread only. Otherwise, the calling thread searches the
+ * first block itself and blocks until all blocks are done. Hence, this method must not be called
+ * from a task running on the same pool.
+ *
+ * @param pool The thread pool used to search the blocks. The number of blocks is at most the size
+ *   of the pool plus one for the calling thread.
+ * @param map The GridMap in which we are looking for the minimum value.
+ * @param row The row index of the minimum. Unchanged if the map has no non-NaN value.
+ * @param col The column index of the minimum. Unchanged if the map has no non-NaN value.
+ * @return The minimum value inside the map or NaN if the map has no non-NaN value.
+ */
+template<typename EigenType>
+typename EigenType::Scalar findMinimumAndIndexParallel( ThreadPool &pool, const EigenType &map,
+                                                        Eigen::Index &row, Eigen::Index &col );
+
+/*!
+ * Parallel variant of findMaximumAndIndex. See findMinimumAndIndexParallel.
+ *
+ * @param pool The thread pool used to search the blocks. The number of blocks is at most the size
+ *   of the pool plus one for the calling thread.
+ * @param map The GridMap in which we are looking for the maximum value.
+ * @param row The row index of the maximum. Unchanged if the map has no non-NaN value.
+ * @param col The column index of the maximum. Unchanged if the map has no non-NaN value.
+ * @return The maximum value inside the map or NaN if the map has no non-NaN value.
+ */
+template<typename EigenType>
+typename EigenType::Scalar findMaximumAndIndexParallel( ThreadPool &pool, const EigenType &map,
+                                                        Eigen::Index &row, Eigen::Index &col );
+
+namespace impl
+{
+/*!
+ * Parallel variant of findExtremumAndIndex. The columns are split into at most pool.size() + 1
+ * blocks with at least min_block_size values each and the block results are merged in ascending
+ * column order, i.e., ties are resolved exactly as in the serial version.
+ */
+template<bool Maximum, typename EigenType>
+bool findExtremumAndIndexParallel( ThreadPool &pool, const EigenType &map, Eigen::Index &row,
+                                   Eigen::Index &col )
+{
+  // Enqueuing a block has a fixed overhead, hence, blocks should be large enough to amortize it
+  constexpr Eigen::Index min_block_size = 1 << 16;
+  // Each worker of the pool gets a block while the calling thread searches the first block
+  const Eigen::Index block_count = std::min<Eigen::Index>(
+      { static_cast<Eigen::Index>( pool.size() ) + 1, map.cols(), map.size() / min_block_size } );
+  if ( block_count <= 1 )
+    return findExtremumAndIndex<Maximum>( map, row, col );
+
+  struct BlockResult {
+    Eigen::Index row = 0;
+    Eigen::Index col = 0;
+    bool found = false;
+  };
+  std::vector<BlockResult> results( block_count );
+  std::vector<Eigen::Index> block_starts( block_count + 1 );
+  // Distribute the columns as evenly as possible, the first blocks get one more column if needed
+  const Eigen::Index cols_per_block = map.cols() / block_count;
+  const Eigen::Index remainder = map.cols() % block_count;
+  block_starts[0] = 0;
+  for ( Eigen::Index i = 0; i < block_count; ++i )
+    block_starts[i + 1] = block_starts[i] + cols_per_block + ( i < remainder ? 1 : 0 );
+  auto search_block = [&map, &results, &block_starts]( Eigen::Index i ) {
+    BlockResult &result = results[i];
+    const Eigen::Index start = block_starts[i];
+    const Eigen::Index cols = block_starts[i + 1] - start;
+    result.found =
+        findExtremumAndIndex<Maximum>( map.middleCols( start, cols ), result.row, result.col );
+    result.col += start;
+  };
+  std::vector<std::future<void>> futures;
+  futures.reserve( block_count - 1 );
+  for ( Eigen::Index i = 1; i < block_count; ++i )
+    futures.push_back( pool.enqueue( [&search_block, i]() { search_block( i ); } ) );
+  // The first block is searched by the calling thread.
+  // All blocks have to be finished before returning since they reference local variables.
+  std::exception_ptr error;
+  try {
+    search_block( 0 );
+  } catch ( ... ) {
+    error = std::current_exception();
+  }
+  for ( auto &future : futures ) future.wait();
+  if ( error )
+    std::rethrow_exception( error );
+  for ( auto &future : futures ) future.get();
+
+  // Merge in block order, only a strictly better value of a later block replaces the current one
+  const BlockResult *best = nullptr;
+  for ( const auto &result : results ) {
+    if ( !result.found )
+      continue;
+    if ( best != nullptr &&
+         !isBetterExtremum<Maximum>( map( result.row, result.col ), map( best->row, best->col ) ) )
+      continue;
+    best = &result;
+  }
+  if ( best == nullptr )
+    return false;
+  row = best->row;
+  col = best->col;
+  return true;
+}
+} // namespace impl
+
+template<typename EigenType>
+typename EigenType::Scalar findMinimumAndIndexParallel( ThreadPool &pool, const EigenType &map,
+                                                        Eigen::Index &row, Eigen::Index &col )
+{
+  if ( !impl::findExtremumAndIndexParallel<false>( pool, map, row, col ) )
+    return impl::initialMinimum<typename EigenType::Scalar>();
+  return map( row, col );
+}
+
+template<typename EigenType>
+typename EigenType::Scalar findMaximumAndIndexParallel( ThreadPool &pool, const EigenType &map,
+                                                        Eigen::Index &row, Eigen::Index &col )
+{
+  if ( !impl::findExtremumAndIndexParallel<true>( pool, map, row, col ) )
+    return impl::initialMaximum<typename EigenType::Scalar>();
+  return map( row, col );
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_FIND_MINMAX_PARALLEL_H
@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_FIND_MINMAX_TILED_H
+#define HECTOR_MATH_FIND_MINMAX_TILED_H
+
+#include "hector_math/containers/tiled_grid_map.h"
+#include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/iterators/tiled_iterator.h"
+#include "hector_math/map_operations/find_minmax.h"
+#include "hector_math/types.h"
+
+namespace hector_math
+{
+
+/*!
+ * Finds the minimum value in the tiled map inside the given polygon.
+ * The polygon is traversed tile by tile, hence, only one tile of the map is accessed at a time.
+ * This method is robust against NaN values in the map.
+ *
+ * @tparam Scalar The floating point type that is used.
+ * @param map The TiledGridMap in which we are looking for the minimum value.
+ * @param polygon The region in which we are looking for the minimum map value. Needs to be in map coordinates.
+ * @return The minimum value or NaN if the entire polygon is outside of the map or the map has no non-NaN value inside the polygon.
+ */
+template<typename Scalar, int TileSize>
+Scalar findMinimum( const TiledGridMap<Scalar, TileSize> &map, const Polygon<Scalar> &polygon );
+
+/*!
+ * Finds the maximum value in the tiled map inside the given polygon.
+ * The polygon is traversed tile by tile, hence, only one tile of the map is accessed at a time.
+ * This method is robust against NaN values in the map.
+ *
+ * @tparam Scalar The floating point type that is used.
+ * @param map The TiledGridMap in which we are looking for the maximum value.
+ * @param polygon The region in which we are looking for the maximum map value. Needs to be in map coordinates.
+ * @return The maximum value or NaN if the entire polygon is outside of the map or the map has no non-NaN value inside the polygon.
+ */
+template<typename Scalar, int TileSize>
+Scalar findMaximum( const TiledGridMap<Scalar, TileSize> &map, const Polygon<Scalar> &polygon );
+
+template<typename Scalar, int TileSize>
+Scalar findMinimum( const TiledGridMap<Scalar, TileSize> &map, const Polygon<Scalar> &polygon )
+{
+  Scalar minimum = impl::initialMinimum<Scalar>();
+  iterateTiledSpans<TileSize>(
+      [&]( auto &&f ) { return iteratePolygonSpans( polygon, map.rows(), map.cols(), f ); },
+      [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        // Runs do not cross tile borders, hence, the cells of a run are contiguous
+        const Scalar *data = map.data( x_start, y );
+        Scalar result = minimum;
+        for ( Eigen::Index i = 0; i < x_end - x_start; ++i ) {
+          const Scalar &val = data[i];
+          if ( std::isnan( val ) || val >= result )
+            continue; // Will be false for NaN
+          result = val;
+        }
+        minimum = result;
+      } );
+  return minimum;
+}
+
+template<typename Scalar, int TileSize>
+Scalar findMaximum( const TiledGridMap<Scalar, TileSize> &map, const Polygon<Scalar> &polygon )
+{
+  Scalar maximum = impl::initialMaximum<Scalar>();
+  iterateTiledSpans<TileSize>(
+      [&]( auto &&f ) { return iteratePolygonSpans( polygon, map.rows(), map.cols(), f ); },
+      [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        // Runs do not cross tile borders, hence, the cells of a run are contiguous
+        const Scalar *data = map.data( x_start, y );
+        Scalar result = maximum;
+        for ( Eigen::Index i = 0; i < x_end - x_start; ++i ) {
+          const Scalar &val = data[i];
+          if ( std::isnan( val ) || val <= result )
+            continue; // Will be false for NaN
+          result = val;
+        }
+        maximum = result;
+      } );
+  return maximum;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_FIND_MINMAX_TILED_H
@@ -0,0 +1,203 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_FIND_STATISTICS_H
+#define HECTOR_MATH_FIND_STATISTICS_H
+
+#include "hector_math/iterators/circle_iterator.h"
+#include "hector_math/iterators/polygon_iterator.h"
+#include "hector_math/iterators/rectangle_iterator.h"
+#include "hector_math/map_operations/minmax_kernels.h"
+#include "hector_math/types.h"
+
+namespace hector_math
+{
+
+template<typename Scalar>
+struct RegionStatistics {
+  //! The minimum value in the region. NaN if there is no valid value.
+  Scalar minimum = std::numeric_limits<Scalar>::quiet_NaN();
+  //! The maximum value in the region. NaN if there is no valid value.
+  Scalar maximum = std::numeric_limits<Scalar>::quiet_NaN();
+  //! The index of the first cell with the minimum value. Only valid if valid_count > 0.
+  Eigen::Index minimum_x = -1;
+  //! The index of the first cell with the minimum value. Only valid if valid_count > 0.
+  Eigen::Index minimum_y = -1;
+  //! The index of the first cell with the maximum value. Only valid if valid_count > 0.
+  Eigen::Index maximum_x = -1;
+  //! The index of the first cell with the maximum value. Only valid if valid_count > 0.
+  Eigen::Index maximum_y = -1;
+  //! The mean of the valid values. NaN if there is no valid value.
+  Scalar mean = std::numeric_limits<Scalar>::quiet_NaN();
+  //! The population variance of the valid values. NaN if there is no valid value.
+  Scalar variance = std::numeric_limits<Scalar>::quiet_NaN();
+  //! The number of cells in the region that are not NaN.
+  Eigen::Index valid_count = 0;
+  //! The number of cells in the region that are NaN.
+  Eigen::Index nan_count = 0;
+};
+
+/*!
+ * Computes the minimum, maximum, their locations, the mean, the variance and the number of valid
+ * and NaN values of the map inside the given polygon in a single pass over the polygon.
+ * The first extremum in the order of iteratePolygon, i.e., ascending y and x, is reported if it
+ * occurs multiple times. NaN values are counted but otherwise ignored.
+ *
+ * @tparam Scalar The floating point type that is used.
+ * @param map The GridMap for which the statistics are computed.
+ * @param polygon The region for which the statistics are computed. Needs to be in the index space
+ *   of the map, see iteratePolygon.
+ * @return The statistics of the region. See RegionStatistics for the values if the region contains
+ *   no valid value.
+ */
+template<typename Scalar>
+RegionStatistics<Scalar> findStatistics( const Eigen::Ref<const GridMap<Scalar>> &map,
+                                         const Polygon<Scalar> &polygon );
+
+/*!
+ * Computes the statistics of the map inside the given circle. See findStatistics for polygons and
+ * iterateCircle for the cells that are inside the circle.
+ *
+ * @tparam Scalar The floating point type that is used.
+ * @param map The GridMap for which the statistics are computed.
+ * @param center The center of the circle in the index space of the map.
+ * @param radius The radius of the circle in the index space of the map.
+ * @return The statistics of the region.
+ */
+template<typename Scalar>
+RegionStatistics<Scalar> findStatistics( const Eigen::Ref<const GridMap<Scalar>> &map,
+                                         const Vector2<Scalar> &center, Scalar radius );
+
+/*!
+ * Computes the statistics of the map inside the rectangle formed by the three points a, b and c
+ * where ab and ac are adjacent edges. See findStatistics for polygons and iterateRectangle for the
+ * cells that are inside the rectangle.
+ *
+ * @tparam Scalar The floating point type that is used.
+ * @param map The GridMap for which the statistics are computed.
+ * @return The statistics of the region.
+ */
+template<typename Scalar>
+RegionStatistics<Scalar> findStatistics( const Eigen::Ref<const GridMap<Scalar>> &map,
+                                         const Vector2<Scalar> &a, const Vector2<Scalar> &b,
+                                         const Vector2<Scalar> &c );
+
+namespace impl
+{
+/*!
+ * Accumulates the statistics of runs of cells.
+ * Each run is processed in two passes while it is in the cache and the mean and variance of the
+ * runs are merged with the pairwise update of Chan et al. which is numerically stable, in contrast
+ * to accumulating the sum of squares.
+ */
+template<typename Scalar>
+class RegionStatisticsAccumulator
+{
+public:
+  //! Adds the cells [x_start, x_end) of column y of the map.
+  void addSpan( const Eigen::Ref<const GridMap<Scalar>> &map, Eigen::Index y, Eigen::Index x_start,
+                Eigen::Index x_end )
+  {
+    // The map is column-major, hence, the cells of a run are contiguous
+    const Scalar *data = map.data() + y * map.outerStride() + x_start;
+    const Eigen::Index length = x_end - x_start;
+    Eigen::Index count = 0;
+    Scalar sum = 0;
+    for ( Eigen::Index i = 0; i < length; ++i ) {
+      const Scalar val = data[i];
+      if ( std::isnan( val ) )
+        continue;
+      ++count;
+      sum += val;
+      if ( isBetterExtremum<false>( val, stats_.minimum ) ) {
+        stats_.minimum = val;
+        stats_.minimum_x = x_start + i;
+        stats_.minimum_y = y;
+      }
+      if ( isBetterExtremum<true>( val, stats_.maximum ) ) {
+        stats_.maximum = val;
+        stats_.maximum_x = x_start + i;
+        stats_.maximum_y = y;
+      }
+    }
+    stats_.nan_count += length - count;
+    if ( count == 0 )
+      return;
+    const Scalar span_mean = sum / count;
+    Scalar span_m2 = 0;
+    for ( Eigen::Index i = 0; i < length; ++i ) {
+      const Scalar delta = data[i] - span_mean;
+      if ( !std::isnan( delta ) )
+        span_m2 += delta * delta;
+    }
+    if ( stats_.valid_count == 0 ) {
+      mean_ = span_mean;
+      m2_ = span_m2;
+      stats_.valid_count = count;
+      return;
+    }
+    const Eigen::Index total = stats_.valid_count + count;
+    const Scalar delta = span_mean - mean_;
+    const Scalar weight = Scalar( count ) / Scalar( total );
+    mean_ += delta * weight;
+    m2_ += span_m2 + delta * delta * Scalar( stats_.valid_count ) * weight;
+    stats_.valid_count = total;
+  }
+
+  RegionStatistics<Scalar> result() const
+  {
+    RegionStatistics<Scalar> result = stats_;
+    if ( result.valid_count > 0 ) {
+      result.mean = mean_;
+      result.variance = m2_ / Scalar( result.valid_count );
+    }
+    return result;
+  }
+
+private:
+  RegionStatistics<Scalar> stats_;
+  Scalar mean_ = 0;
+  //! The sum of squared differences from the mean.
+  Scalar m2_ = 0;
+};
+} // namespace impl
+
+template<typename Scalar>
+RegionStatistics<Scalar> findStatistics( const Eigen::Ref<const GridMap<Scalar>> &map,
+                                         const Polygon<Scalar> &polygon )
+{
+  impl::RegionStatisticsAccumulator<Scalar> accumulator;
+  iteratePolygonSpans( polygon, map.rows(), map.cols(),
+                       [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                         accumulator.addSpan( map, y, x_start, x_end );
+                       } );
+  return accumulator.result();
+}
+
+template<typename Scalar>
+RegionStatistics<Scalar> findStatistics( const Eigen::Ref<const GridMap<Scalar>> &map,
+                                         const Vector2<Scalar> &center, Scalar radius )
+{
+  impl::RegionStatisticsAccumulator<Scalar> accumulator;
+  iterateCircleSpans( center, radius, map.rows(), map.cols(),
+                      [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                        accumulator.addSpan( map, y, x_start, x_end );
+                      } );
+  return accumulator.result();
+}
+
+template<typename Scalar>
+RegionStatistics<Scalar> findStatistics( const Eigen::Ref<const GridMap<Scalar>> &map,
+                                         const Vector2<Scalar> &a, const Vector2<Scalar> &b,
+                                         const Vector2<Scalar> &c )
+{
+  impl::RegionStatisticsAccumulator<Scalar> accumulator;
+  iterateRectangleSpans( a, b, c, map.rows(), map.cols(),
+                         [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                           accumulator.addSpan( map, y, x_start, x_end );
+                         } );
+  return accumulator.result();
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_FIND_STATISTICS_H
@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_INTEGRAL_IMAGE_H
+#define HECTOR_MATH_INTEGRAL_IMAGE_H
+
+#include "hector_math/types.h"
+#include <algorithm>
+#include <cmath>
+
+namespace hector_math
+{
+
+/*!
+ * A summed-area table of a GridMap that answers sum, mean and variance queries for axis-aligned
+ * rectangles in constant time, e.g., for sliding window features over a whole map.
+ * The table stores the sum, the sum of squares and the number of valid values of all cells in
+ * [0, x) x [0, y) for each (x, y). Values that are not finite, e.g., NaN for unknown cells, are
+ * ignored.
+ *
+ * The sums are accumulated in double relative to the first valid value of the map to reduce the
+ * cancellation when computing the variance of values with a large offset, e.g., elevations.
+ * If only a part of the map changed, the table can be updated using update which recomputes only
+ * the entries that depend on the changed cells.
+ *
+ * The rectangles are given as the block [x, x + rows) x [y, y + cols), as for Eigen's block, and
+ * are clamped to the map.
+ */
+template<typename Scalar>
+class IntegralImage
+{
+public:
+  IntegralImage() = default;
+
+  //! Computes the table for the given map.
+  explicit IntegralImage( const Eigen::Ref<const GridMap<Scalar>> &map ) { compute( map ); }
+
+  //! Computes the table for the given map, replacing any previous content.
+  void compute( const Eigen::Ref<const GridMap<Scalar>> &map )
+  {
+    rows_ = map.rows();
+    cols_ = map.cols();
+    sum_.setZero( rows_ + 1, cols_ + 1 );
+    sum_squares_.setZero( rows_ + 1, cols_ + 1 );
+    count_.setZero( rows_ + 1, cols_ + 1 );
+    offset_ = 0;
+    for ( Eigen::Index i = 0; i < map.size(); ++i ) {
+      const Scalar &val = map( i % rows_, i / rows_ );
+      if ( !std::isfinite( val ) )
+        continue;
+      offset_ = val;
+      break;
+    }
+    computeBlock( map, 0, 0 );
+  }
+
+  /*!
+   * Updates the table after the cells in the block [x, x + rows) x [y, y + cols) of the map
+   * changed. All entries that contain one of the cells are recomputed, i.e., the cost is
+   * proportional to the size of [x, map.rows()) x [y, map.cols()) and not of the whole map.
+   * The map has to have the same size as the map the table was computed for.
+   */
+  void update( const Eigen::Ref<const GridMap<Scalar>> &map, Eigen::Index x, Eigen::Index y,
+               Eigen::Index rows, Eigen::Index cols )
+  {
+    if ( map.rows() != rows_ || map.cols() != cols_ ) {
+      compute( map );
+      return;
+    }
+    if ( !clamp( x, y, rows, cols ) )
+      return;
+    computeBlock( map, x, y );
+  }
+
+  //! @returns The number of rows of the map, i.e., the size in x direction.
+  Eigen::Index rows() const { return rows_; }
+  //! @returns The number of columns of the map, i.e., the size in y direction.
+  Eigen::Index cols() const { return cols_; }
+
+  //! @returns The number of finite values in the block [x, x + rows) x [y, y + cols).
+  Eigen::Index count( Eigen::Index x, Eigen::Index y, Eigen::Index rows, Eigen::Index cols ) const
+  {
+    if ( !clamp( x, y, rows, cols ) )
+      return 0;
+    return blockSum( count_, x, y, rows, cols );
+  }
+
+  //! @returns The sum of the finite values in the block [x, x + rows) x [y, y + cols).
+  Scalar sum( Eigen::Index x, Eigen::Index y, Eigen::Index rows, Eigen::Index cols ) const
+  {
+    if ( !clamp( x, y, rows, cols ) )
+      return 0;
+    const Eigen::Index count = blockSum( count_, x, y, rows, cols );
+    return static_cast<Scalar>( blockSum( sum_, x, y, rows, cols ) + count * offset_ );
+  }
+
+  /*!
+   * @returns The mean of the finite values in the block [x, x + rows) x [y, y + cols) or NaN if
+   *   there are none.
+   */
+  Scalar mean( Eigen::Index x, Eigen::Index y, Eigen::Index rows, Eigen::Index cols ) const
+  {
+    if ( !clamp( x, y, rows, cols ) )
+      return std::numeric_limits<Scalar>::quiet_NaN();
+    const Eigen::Index count = blockSum( count_, x, y, rows, cols );
+    if ( count == 0 )
+      return std::numeric_limits<Scalar>::quiet_NaN();
+    return static_cast<Scalar>( blockSum( sum_, x, y, rows, cols ) / count + offset_ );
+  }
+
+  /*!
+   * @returns The population variance of the finite values in the block [x, x + rows) x
+   *   [y, y + cols) or NaN if there are none.
+   */
+  Scalar variance( Eigen::Index x, Eigen::Index y, Eigen::Index rows, Eigen::Index cols ) const
+  {
+    if ( !clamp( x, y, rows, cols ) )
+      return std::numeric_limits<Scalar>::quiet_NaN();
+    const Eigen::Index count = blockSum( count_, x, y, rows, cols );
+    if ( count == 0 )
+      return std::numeric_limits<Scalar>::quiet_NaN();
+    const double mean = blockSum( sum_, x, y, rows, cols ) / count;
+    const double variance = blockSum( sum_squares_, x, y, rows, cols ) / count - mean * mean;
+    // Rounding errors may result in slightly negative values for constant blocks
+    return static_cast<Scalar>( std::max( 0.0, variance ) );
+  }
+
+private:
+  //! Clamps the block to the map. @returns False if the clamped block is empty.
+  bool clamp( Eigen::Index &x, Eigen::Index &y, Eigen::Index &rows, Eigen::Index &cols ) const
+  {
+    const Eigen::Index x_end = std::min( rows_, x + rows );
+    const Eigen::Index y_end = std::min( cols_, y + cols );
+    x = std::max<Eigen::Index>( 0, x );
+    y = std::max<Eigen::Index>( 0, y );
+    rows = x_end - x;
+    cols = y_end - y;
+    return rows > 0 && cols > 0;
+  }
+
+  template<typename Table>
+  static typename Table::Scalar blockSum( const Table &table, Eigen::Index x, Eigen::Index y,
+                                          Eigen::Index rows, Eigen::Index cols )
+  {
+    return table( x + rows, y + cols ) - table( x, y + cols ) - table( x + rows, y ) +
+           table( x, y );
+  }
+
+  //! Recomputes all entries (x', y') with x' > x and y' > y.
+  void computeBlock( const Eigen::Ref<const GridMap<Scalar>> &map, Eigen::Index x, Eigen::Index y )
+  {
+    for ( Eigen::Index col = y; col < cols_; ++col ) {
+      // The sums of the cells [0, x) of this column are the difference of the previous entries
+      double column_sum = sum_( x, col + 1 ) - sum_( x, col );
+      double column_sum_squares = sum_squares_( x, col + 1 ) - sum_squares_( x, col );
+      Eigen::Index column_count = count_( x, col + 1 ) - count_( x, col );
+      const Scalar *data = map.data() + col * map.outerStride();
+      for ( Eigen::Index row = x; row < rows_; ++row ) {
+        const Scalar &val = data[row];
+        if ( std::isfinite( val ) ) {
+          const double shifted = double( val ) - offset_;
+          column_sum += shifted;
+          column_sum_squares += shifted * shifted;
+          ++column_count;
+        }
+        sum_( row + 1, col + 1 ) = sum_( row + 1, col ) + column_sum;
+        sum_squares_( row + 1, col + 1 ) = sum_squares_( row + 1, col ) + column_sum_squares;
+        count_( row + 1, col + 1 ) = count_( row + 1, col ) + column_count;
+      }
+    }
+  }
+
+  Eigen::ArrayXXd sum_;
+  Eigen::ArrayXXd sum_squares_;
+  Eigen::Array<Eigen::Index, Eigen::Dynamic, Eigen::Dynamic> count_;
+  double offset_ = 0;
+  Eigen::Index rows_ = 0;
+  Eigen::Index cols_ = 0;
+};
+} // namespace hector_math
+
+#endif // HECTOR_MATH_INTEGRAL_IMAGE_H
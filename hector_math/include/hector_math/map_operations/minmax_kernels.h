@@ -0,0 +1,385 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_MINMAX_KERNELS_H
+#define HECTOR_MATH_MINMAX_KERNELS_H
+
+#include "hector_math/types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// The instruction set is picked at compile time. Define HECTOR_MATH_DISABLE_SIMD to always use the
+// scalar implementation.
+#if !defined( HECTOR_MATH_DISABLE_SIMD )
+#if defined( __AVX2__ )
+#include <immintrin.h>
+#define HECTOR_MATH_MINMAX_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+#include <emmintrin.h>
+#define HECTOR_MATH_MINMAX_SSE2
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+#include <arm_neon.h>
+#define HECTOR_MATH_MINMAX_NEON
+#endif
+#endif
+
+namespace hector_math
+{
+namespace impl
+{
+template<typename Scalar, typename std::enable_if<std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
+constexpr Scalar initialMinimum()
+{
+  return std::numeric_limits<Scalar>::quiet_NaN();
+}
+
+template<typename Scalar,
+         typename std::enable_if<!std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
+constexpr Scalar initialMinimum()
+{
+  return std::numeric_limits<Scalar>::max();
+}
+
+template<typename Scalar, typename std::enable_if<std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
+constexpr Scalar initialMaximum()
+{
+  return std::numeric_limits<Scalar>::quiet_NaN();
+}
+
+template<typename Scalar,
+         typename std::enable_if<!std::numeric_limits<Scalar>::has_quiet_NaN, int>::type = 0>
+constexpr Scalar initialMaximum()
+{
+  return std::numeric_limits<Scalar>::min();
+}
+
+/*!
+ * @return True if value is not NaN and strictly smaller (or larger if Maximum) than best.
+ *   If best is NaN, i.e., no value was found yet, every value that is not NaN is better.
+ */
+template<bool Maximum, typename Scalar>
+inline bool isBetterExtremum( const Scalar &value, const Scalar &best )
+{
+  if ( std::isnan( value ) )
+    return false;
+  return Maximum ? !( value <= best ) : !( value >= best );
+}
+
+//! Scalar implementation of findExtremumIndex.
+template<bool Maximum, typename Scalar>
+Eigen::Index findExtremumIndexScalar( const Scalar *data, Eigen::Index count )
+{
+  Eigen::Index index = -1;
+  Scalar best = Maximum ? initialMaximum<Scalar>() : initialMinimum<Scalar>();
+  for ( Eigen::Index i = 0; i < count; ++i ) {
+    if ( !isBetterExtremum<Maximum>( data[i], best ) )
+      continue;
+    best = data[i];
+    index = i;
+  }
+  return index;
+}
+
+/*!
+ * Vector operations for the kernel in findExtremumIndexSimd.
+ * Each lane tracks its best value and the index of its first occurrence.
+ * Specialized for float and double depending on the available instruction set.
+ */
+template<typename Scalar>
+struct MinMaxSimdOps {
+  static constexpr bool Available = false;
+};
+
+#if defined( HECTOR_MATH_MINMAX_AVX2 )
+template<>
+struct MinMaxSimdOps<float> {
+  static constexpr bool Available = true;
+  static constexpr int Lanes = 8;
+  using Vector = __m256;
+  using IndexVector = __m256i;
+  using IndexType = int32_t;
+
+  static Vector load( const float *data ) { return _mm256_loadu_ps( data ); }
+  static Vector nan() { return _mm256_set1_ps( std::numeric_limits<float>::quiet_NaN() ); }
+  static IndexVector firstIndexes() { return _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ); }
+  static IndexVector broadcast( IndexType value ) { return _mm256_set1_epi32( value ); }
+  static IndexVector add( IndexVector a, IndexVector b ) { return _mm256_add_epi32( a, b ); }
+  template<bool Maximum>
+  static Vector better( Vector value, Vector best )
+  {
+    // Not ordered-less-equal (or greater-equal) is true if best is NaN, hence, masked with ordered
+    const Vector compare = _mm256_cmp_ps( value, best, Maximum ? _CMP_NLE_UQ : _CMP_NGE_UQ );
+    return _mm256_and_ps( compare, _mm256_cmp_ps( value, value, _CMP_ORD_Q ) );
+  }
+  static Vector select( Vector mask, Vector a, Vector b ) { return _mm256_blendv_ps( b, a, mask ); }
+  static IndexVector select( Vector mask, IndexVector a, IndexVector b )
+  {
+    return _mm256_castps_si256(
+        _mm256_blendv_ps( _mm256_castsi256_ps( b ), _mm256_castsi256_ps( a ), mask ) );
+  }
+  static void store( float *out, Vector value ) { _mm256_storeu_ps( out, value ); }
+  static void store( IndexType *out, IndexVector value )
+  {
+    _mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), value );
+  }
+};
+
+template<>
+struct MinMaxSimdOps<double> {
+  static constexpr bool Available = true;
+  static constexpr int Lanes = 4;
+  using Vector = __m256d;
+  using IndexVector = __m256i;
+  using IndexType = int64_t;
+
+  static Vector load( const double *data ) { return _mm256_loadu_pd( data ); }
+  static Vector nan() { return _mm256_set1_pd( std::numeric_limits<double>::quiet_NaN() ); }
+  static IndexVector firstIndexes() { return _mm256_setr_epi64x( 0, 1, 2, 3 ); }
+  static IndexVector broadcast( IndexType value ) { return _mm256_set1_epi64x( value ); }
+  static IndexVector add( IndexVector a, IndexVector b ) { return _mm256_add_epi64( a, b ); }
+  template<bool Maximum>
+  static Vector better( Vector value, Vector best )
+  {
+    const Vector compare = _mm256_cmp_pd( value, best, Maximum ? _CMP_NLE_UQ : _CMP_NGE_UQ );
+    return _mm256_and_pd( compare, _mm256_cmp_pd( value, value, _CMP_ORD_Q ) );
+  }
+  static Vector select( Vector mask, Vector a, Vector b ) { return _mm256_blendv_pd( b, a, mask ); }
+  static IndexVector select( Vector mask, IndexVector a, IndexVector b )
+  {
+    return _mm256_castpd_si256(
+        _mm256_blendv_pd( _mm256_castsi256_pd( b ), _mm256_castsi256_pd( a ), mask ) );
+  }
+  static void store( double *out, Vector value ) { _mm256_storeu_pd( out, value ); }
+  static void store( IndexType *out, IndexVector value )
+  {
+    _mm256_storeu_si256( reinterpret_cast<__m256i *>( out ), value );
+  }
+};
+#elif defined( HECTOR_MATH_MINMAX_SSE2 )
+template<>
+struct MinMaxSimdOps<float> {
+  static constexpr bool Available = true;
+  static constexpr int Lanes = 4;
+  using Vector = __m128;
+  using IndexVector = __m128i;
+  using IndexType = int32_t;
+
+  static Vector load( const float *data ) { return _mm_loadu_ps( data ); }
+  static Vector nan() { return _mm_set1_ps( std::numeric_limits<float>::quiet_NaN() ); }
+  static IndexVector firstIndexes() { return _mm_setr_epi32( 0, 1, 2, 3 ); }
+  static IndexVector broadcast( IndexType value ) { return _mm_set1_epi32( value ); }
+  static IndexVector add( IndexVector a, IndexVector b ) { return _mm_add_epi32( a, b ); }
+  template<bool Maximum>
+  static Vector better( Vector value, Vector best )
+  {
+    // Not-less-equal (or not-greater-equal) is true if best is NaN, hence, masked with ordered
+    const Vector compare = Maximum ? _mm_cmpnle_ps( value, best ) : _mm_cmpnge_ps( value, best );
+    return _mm_and_ps( compare, _mm_cmpord_ps( value, value ) );
+  }
+  static Vector select( Vector mask, Vector a, Vector b )
+  {
+    return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) );
+  }
+  static IndexVector select( Vector mask, IndexVector a, IndexVector b )
+  {
+    const IndexVector int_mask = _mm_castps_si128( mask );
+    return _mm_or_si128( _mm_and_si128( int_mask, a ), _mm_andnot_si128( int_mask, b ) );
+  }
+  static void store( float *out, Vector value ) { _mm_storeu_ps( out, value ); }
+  static void store( IndexType *out, IndexVector value )
+  {
+    _mm_storeu_si128( reinterpret_cast<__m128i *>( out ), value );
+  }
+};
+
+template<>
+struct MinMaxSimdOps<double> {
+  static constexpr bool Available = true;
+  static constexpr int Lanes = 2;
+  using Vector = __m128d;
+  using IndexVector = __m128i;
+  using IndexType = int64_t;
+
+  static Vector load( const double *data ) { return _mm_loadu_pd( data ); }
+  static Vector nan() { return _mm_set1_pd( std::numeric_limits<double>::quiet_NaN() ); }
+  static IndexVector firstIndexes() { return _mm_set_epi64x( 1, 0 ); }
+  static IndexVector broadcast( IndexType value ) { return _mm_set1_epi64x( value ); }
+  static IndexVector add( IndexVector a, IndexVector b ) { return _mm_add_epi64( a, b ); }
+  template<bool Maximum>
+  static Vector better( Vector value, Vector best )
+  {
+    const Vector compare = Maximum ? _mm_cmpnle_pd( value, best ) : _mm_cmpnge_pd( value, best );
+    return _mm_and_pd( compare, _mm_cmpord_pd( value, value ) );
+  }
+  static Vector select( Vector mask, Vector a, Vector b )
+  {
+    return _mm_or_pd( _mm_and_pd( mask, a ), _mm_andnot_pd( mask, b ) );
+  }
+  static IndexVector select( Vector mask, IndexVector a, IndexVector b )
+  {
+    const IndexVector int_mask = _mm_castpd_si128( mask );
+    return _mm_or_si128( _mm_and_si128( int_mask, a ), _mm_andnot_si128( int_mask, b ) );
+  }
+  static void store( double *out, Vector value ) { _mm_storeu_pd( out, value ); }
+  static void store( IndexType *out, IndexVector value )
+  {
+    _mm_storeu_si128( reinterpret_cast<__m128i *>( out ), value );
+  }
+};
+#elif defined( HECTOR_MATH_MINMAX_NEON )
+template<>
+struct MinMaxSimdOps<float> {
+  static constexpr bool Available = true;
+  static constexpr int Lanes = 4;
+  using Vector = float32x4_t;
+  using Mask = uint32x4_t;
+  using IndexVector = int32x4_t;
+  using IndexType = int32_t;
+
+  static Vector load( const float *data ) { return vld1q_f32( data ); }
+  static Vector nan() { return vdupq_n_f32( std::numeric_limits<float>::quiet_NaN() ); }
+  static IndexVector firstIndexes()
+  {
+    const IndexType indexes[4] = { 0, 1, 2, 3 };
+    return vld1q_s32( indexes );
+  }
+  static IndexVector broadcast( IndexType value ) { return vdupq_n_s32( value ); }
+  static IndexVector add( IndexVector a, IndexVector b ) { return vaddq_s32( a, b ); }
+  template<bool Maximum>
+  static Mask better( Vector value, Vector best )
+  {
+    // Ordered and not less-equal (or greater-equal) which is false for NaN values
+    const Mask compare = Maximum ? vcleq_f32( value, best ) : vcgeq_f32( value, best );
+    return vbicq_u32( vceqq_f32( value, value ), compare );
+  }
+  static Vector select( Mask mask, Vector a, Vector b ) { return vbslq_f32( mask, a, b ); }
+  static IndexVector select( Mask mask, IndexVector a, IndexVector b )
+  {
+    return vbslq_s32( mask, a, b );
+  }
+  static void store( float *out, Vector value ) { vst1q_f32( out, value ); }
+  static void store( IndexType *out, IndexVector value ) { vst1q_s32( out, value ); }
+};
+
+template<>
+struct MinMaxSimdOps<double> {
+  static constexpr bool Available = true;
+  static constexpr int Lanes = 2;
+  using Vector = float64x2_t;
+  using Mask = uint64x2_t;
+  using IndexVector = int64x2_t;
+  using IndexType = int64_t;
+
+  static Vector load( const double *data ) { return vld1q_f64( data ); }
+  static Vector nan() { return vdupq_n_f64( std::numeric_limits<double>::quiet_NaN() ); }
+  static IndexVector firstIndexes()
+  {
+    const IndexType indexes[2] = { 0, 1 };
+    return vld1q_s64( indexes );
+  }
+  static IndexVector broadcast( IndexType value ) { return vdupq_n_s64( value ); }
+  static IndexVector add( IndexVector a, IndexVector b ) { return vaddq_s64( a, b ); }
+  template<bool Maximum>
+  static Mask better( Vector value, Vector best )
+  {
+    const Mask compare = Maximum ? vcleq_f64( value, best ) : vcgeq_f64( value, best );
+    return vbicq_u64( vceqq_f64( value, value ), compare );
+  }
+  static Vector select( Mask mask, Vector a, Vector b ) { return vbslq_f64( mask, a, b ); }
+  static IndexVector select( Mask mask, IndexVector a, IndexVector b )
+  {
+    return vbslq_s64( mask, a, b );
+  }
+  static void store( double *out, Vector value ) { vst1q_f64( out, value ); }
+  static void store( IndexType *out, IndexVector value ) { vst1q_s64( out, value ); }
+};
+#endif
+
+/*!
+ * Vectorized implementation of findExtremumIndex.
+ * Two sets of lanes are used to hide the latency of the compare and select chain. Each lane keeps
+ * its best value and the index of its first occurrence, hence, the result is the same as for the
+ * scalar implementation.
+ * The count has to fit into the IndexType of the operations.
+ */
+template<bool Maximum, typename Scalar>
+Eigen::Index findExtremumIndexSimd( const Scalar *data, Eigen::Index count )
+{
+  using Ops = MinMaxSimdOps<Scalar>;
+  using IndexType = typename Ops::IndexType;
+  constexpr int Lanes = Ops::Lanes;
+  auto best_a = Ops::nan(), best_b = Ops::nan();
+  auto best_index_a = Ops::broadcast( -1 ), best_index_b = Ops::broadcast( -1 );
+  auto index_a = Ops::firstIndexes();
+  auto index_b = Ops::add( index_a, Ops::broadcast( Lanes ) );
+  const auto step = Ops::broadcast( 2 * Lanes );
+  Eigen::Index i = 0;
+  for ( ; i + 2 * Lanes <= count; i += 2 * Lanes ) {
+    const auto value_a = Ops::load( data + i );
+    const auto value_b = Ops::load( data + i + Lanes );
+    const auto better_a = Ops::template better<Maximum>( value_a, best_a );
+    const auto better_b = Ops::template better<Maximum>( value_b, best_b );
+    best_a = Ops::select( better_a, value_a, best_a );
+    best_b = Ops::select( better_b, value_b, best_b );
+    best_index_a = Ops::select( better_a, index_a, best_index_a );
+    best_index_b = Ops::select( better_b, index_b, best_index_b );
+    index_a = Ops::add( index_a, step );
+    index_b = Ops::add( index_b, step );
+  }
+  Scalar values[2 * Lanes];
+  IndexType indexes[2 * Lanes];
+  Ops::store( values, best_a );
+  Ops::store( values + Lanes, best_b );
+  Ops::store( indexes, best_index_a );
+  Ops::store( indexes + Lanes, best_index_b );
+
+  // Reduce the lanes. Equal values are resolved to the first occurrence.
+  Eigen::Index index = -1;
+  for ( int lane = 0; lane < 2 * Lanes; ++lane ) {
+    if ( indexes[lane] < 0 )
+      continue;
+    if ( index == -1 || isBetterExtremum<Maximum>( values[lane], data[index] ) ||
+         ( values[lane] == data[index] && indexes[lane] < index ) )
+      index = indexes[lane];
+  }
+  // The remaining values are after all values of the lanes
+  for ( ; i < count; ++i ) {
+    if ( index == -1 ? !std::isnan( data[i] ) : isBetterExtremum<Maximum>( data[i], data[index] ) )
+      index = i;
+  }
+  return index;
+}
+
+/*!
+ * Finds the index of the first minimum (or maximum if Maximum is true) of the count contiguous
+ * values starting at data. NaN values are ignored.
+ * Uses SIMD instructions for float and double if available (AVX2, SSE2 or NEON on AArch64).
+ * @return The index of the extremum or -1 if there is no value that is not NaN.
+ */
+template<bool Maximum, typename Scalar>
+Eigen::Index findExtremumIndex( const Scalar *data, Eigen::Index count )
+{
+  if constexpr ( MinMaxSimdOps<Scalar>::Available ) {
+    // The lanes use IndexType indexes, hence, long arrays are split into chunks
+    constexpr Eigen::Index chunk_size = Eigen::Index( 1 ) << 30;
+    Eigen::Index index = -1;
+    for ( Eigen::Index start = 0; start < count; start += chunk_size ) {
+      const Eigen::Index chunk_index = findExtremumIndexSimd<Maximum>(
+          data + start, std::min( chunk_size, count - start ) );
+      if ( chunk_index == -1 )
+        continue;
+      if ( index == -1 || isBetterExtremum<Maximum>( data[start + chunk_index], data[index] ) )
+        index = start + chunk_index;
+    }
+    return index;
+  } else {
+    return findExtremumIndexScalar<Maximum>( data, count );
+  }
+}
+} // namespace impl
+} // namespace hector_math
+
+#endif // HECTOR_MATH_MINMAX_KERNELS_H
@@ -0,0 +1,175 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_RANGE_EXTREMUM_TABLE_H
+#define HECTOR_MATH_RANGE_EXTREMUM_TABLE_H
+
+#include "hector_math/map_operations/minmax_kernels.h"
+#include "hector_math/types.h"
+#include <algorithm>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * A 2D sparse table of a GridMap that answers minimum (or maximum if Maximum is true) queries for
+ * axis-aligned rectangles, e.g., for step height checks of a footprint, in constant time.
+ * Level (i, j) of the table stores the extremum of the block of 2^i x 2^j cells starting at each
+ * cell. A query is answered with the (up to) four overlapping blocks of the largest levels that fit
+ * into the rectangle. NaN values are ignored. The result is NaN if the rectangle contains no value
+ * that is not NaN or is outside of the map.
+ *
+ * Memory / speed tradeoff: A table with all levels requires up to
+ * rows * cols * (log2(rows) + 1) * (log2(cols) + 1) values, e.g., 121 times the size of the map
+ * for a 1024 x 1024 map. Hence, the levels are limited to max_level, i.e., blocks of at most
+ * 2^max_level cells per side, which limits the memory to (max_level + 1)^2 times the size of the
+ * map. Rectangles with at most 2^(max_level + 1) cells per side are answered with four lookups,
+ * larger rectangles require about (rows / 2^max_level) * (cols / 2^max_level) lookups.
+ * Building the table takes time proportional to its size.
+ *
+ * The rectangles are given as the block [x, x + rows) x [y, y + cols), as for Eigen's block, and
+ * are clamped to the map.
+ * @tparam Scalar The floating point type of the map.
+ * @tparam Maximum Whether the table answers maximum (true) or minimum (false) queries.
+ */
+template<typename Scalar, bool Maximum>
+class RangeExtremumTable
+{
+public:
+  RangeExtremumTable() = default;
+
+  /*!
+   * @param map The map for which the table is computed.
+   * @param max_level The largest level, i.e., the blocks have at most 2^max_level cells per side.
+   *   See the class documentation for the memory / speed tradeoff.
+   */
+  explicit RangeExtremumTable( const Eigen::Ref<const GridMap<Scalar>> &map, int max_level = 5 )
+  {
+    compute( map, max_level );
+  }
+
+  //! Computes the table for the given map, replacing any previous content.
+  void compute( const Eigen::Ref<const GridMap<Scalar>> &map, int max_level = 5 )
+  {
+    rows_ = map.rows();
+    cols_ = map.cols();
+    levels_x_ = std::min( std::max( 0, max_level ), floorLog2( rows_ ) ) + 1;
+    levels_y_ = std::min( std::max( 0, max_level ), floorLog2( cols_ ) ) + 1;
+    levels_.clear();
+    if ( rows_ == 0 || cols_ == 0 )
+      return;
+    levels_.resize( levels_x_ * levels_y_ );
+    level( 0, 0 ) = map;
+    for ( int i = 0; i < levels_x_; ++i ) {
+      if ( i > 0 ) {
+        // Combine two blocks of the previous level in x direction
+        const GridMap<Scalar> &previous = level( i - 1, 0 );
+        const Eigen::Index half = Eigen::Index( 1 ) << ( i - 1 );
+        const Eigen::Index rows = rows_ - 2 * half + 1;
+        level( i, 0 ) = combine( previous.topRows( rows ), previous.middleRows( half, rows ) );
+      }
+      for ( int j = 1; j < levels_y_; ++j ) {
+        // Combine two blocks of the previous level in y direction
+        const GridMap<Scalar> &previous = level( i, j - 1 );
+        const Eigen::Index half = Eigen::Index( 1 ) << ( j - 1 );
+        const Eigen::Index cols = cols_ - 2 * half + 1;
+        level( i, j ) = combine( previous.leftCols( cols ), previous.middleCols( half, cols ) );
+      }
+    }
+  }
+
+  //! @returns The number of rows of the map, i.e., the size in x direction.
+  Eigen::Index rows() const { return rows_; }
+  //! @returns The number of columns of the map, i.e., the size in y direction.
+  Eigen::Index cols() const { return cols_; }
+
+  //! @returns The number of values stored in the table.
+  Eigen::Index size() const
+  {
+    Eigen::Index result = 0;
+    for ( const auto &table : levels_ ) result += table.size();
+    return result;
+  }
+
+  /*!
+   * @returns The minimum (or maximum) of the values that are not NaN in the block
+   *   [x, x + rows) x [y, y + cols) or NaN if there are none.
+   */
+  Scalar query( Eigen::Index x, Eigen::Index y, Eigen::Index rows, Eigen::Index cols ) const
+  {
+    const Eigen::Index x_end = std::min( rows_, x + rows );
+    const Eigen::Index y_end = std::min( cols_, y + cols );
+    x = std::max<Eigen::Index>( 0, x );
+    y = std::max<Eigen::Index>( 0, y );
+    if ( x >= x_end || y >= y_end )
+      return std::numeric_limits<Scalar>::quiet_NaN();
+    const int i = std::min( levels_x_ - 1, floorLog2( x_end - x ) );
+    const int j = std::min( levels_y_ - 1, floorLog2( y_end - y ) );
+    const Eigen::Index size_x = Eigen::Index( 1 ) << i;
+    const Eigen::Index size_y = Eigen::Index( 1 ) << j;
+    const GridMap<Scalar> &table = level( i, j );
+    if ( x_end - x <= 2 * size_x && y_end - y <= 2 * size_y ) {
+      // The four blocks at the corners cover the rectangle
+      const Scalar a = better( table( x, y ), table( x_end - size_x, y ) );
+      const Scalar b =
+          better( table( x, y_end - size_y ), table( x_end - size_x, y_end - size_y ) );
+      return better( a, b );
+    }
+    // Cover the rectangle with blocks of the largest level, the last blocks overlap the previous
+    Scalar result = std::numeric_limits<Scalar>::quiet_NaN();
+    for ( Eigen::Index block_y = y;; block_y += size_y ) {
+      block_y = std::min( block_y, y_end - size_y );
+      for ( Eigen::Index block_x = x;; block_x += size_x ) {
+        block_x = std::min( block_x, x_end - size_x );
+        result = better( result, table( block_x, block_y ) );
+        if ( block_x == x_end - size_x )
+          break;
+      }
+      if ( block_y == y_end - size_y )
+        break;
+    }
+    return result;
+  }
+
+private:
+  static int floorLog2( Eigen::Index value )
+  {
+    int result = -1;
+    for ( ; value > 0; value >>= 1 ) ++result;
+    return result;
+  }
+
+  //! @returns b if it is better than a, a otherwise. NaN values are only returned if both are NaN.
+  static Scalar better( Scalar a, Scalar b )
+  {
+    return impl::isBetterExtremum<Maximum>( b, a ) ? b : a;
+  }
+
+  template<typename A, typename B>
+  static GridMap<Scalar> combine( const A &a, const B &b )
+  {
+    return a.binaryExpr( b, []( Scalar u, Scalar v ) { return better( u, v ); } );
+  }
+
+  GridMap<Scalar> &level( int i, int j ) { return levels_[i * levels_y_ + j]; }
+
+  const GridMap<Scalar> &level( int i, int j ) const { return levels_[i * levels_y_ + j]; }
+
+  std::vector<GridMap<Scalar>> levels_;
+  Eigen::Index rows_ = 0;
+  Eigen::Index cols_ = 0;
+  int levels_x_ = 0;
+  int levels_y_ = 0;
+};
+
+//! A RangeExtremumTable that answers minimum queries.
+template<typename Scalar>
+using RangeMinimumTable = RangeExtremumTable<Scalar, false>;
+
+//! A RangeExtremumTable that answers maximum queries.
+template<typename Scalar>
+using RangeMaximumTable = RangeExtremumTable<Scalar, true>;
+} // namespace hector_math
+
+#endif // HECTOR_MATH_RANGE_EXTREMUM_TABLE_H
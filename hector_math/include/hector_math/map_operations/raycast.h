@@ -0,0 +1,155 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_RAYCAST_H
+#define HECTOR_MATH_RAYCAST_H
+
+#include "hector_math/iterators/line_iterator.h"
+#include "hector_math/parallel/thread_pool.h"
+#include "hector_math/types.h"
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace hector_math
+{
+
+template<typename Scalar>
+struct RaycastResult {
+  //! The index of the first cell that was hit. Only valid if hit is true.
+  Eigen::Index x = -1;
+  //! The index of the first cell that was hit. Only valid if hit is true.
+  Eigen::Index y = -1;
+  //! The distance from the origin to the point where the ray enters the hit cell (in map units).
+  //! Only valid if hit is true.
+  Scalar range = std::numeric_limits<Scalar>::quiet_NaN();
+  //! Whether the ray hit a cell before reaching its end point or leaving the map.
+  bool hit = false;
+};
+
+/*!
+ * Casts a single ray from origin to end through the height map and returns the first cell where
+ * the height of the map is greater or equal to the height of the ray inside that cell.
+ * The ray traverses all cells touched by its projection onto the map (see iterateLineSupercover)
+ * and the lowest height of the ray inside a cell is used for the comparison. Cells with NaN
+ * values are treated as unknown and never hit.
+ *
+ * @param map The height map.
+ * @param resolution The resolution of the map.
+ * @param origin The origin of the ray in map coordinates relative to the corner of the cell (0, 0),
+ *   i.e., origin.head<2>() / resolution is in the index space of the map. The z component is the
+ *   height in the same unit as the map values.
+ * @param end The end point of the ray in the same frame as the origin.
+ * @return The first cell that was hit, if any.
+ */
+template<typename Scalar>
+RaycastResult<Scalar> raycastHeightMap( const GridMap<Scalar> &map, Scalar resolution,
+                                        const Vector3<Scalar> &origin, const Vector3<Scalar> &end );
+
+/*!
+ * Casts a batch of rays from a common origin through the height map, e.g., to insert a LiDAR scan
+ * or to perform visibility checks. See raycastHeightMap for a single ray for the semantics.
+ *
+ * The rays are sorted by their direction and processed in batches of neighboring rays which
+ * traverse mostly the same cells and, hence, benefit from the cells being in the cache.
+ * If a thread pool is given, the batches are processed concurrently on the pool.
+ *
+ * @param map The height map.
+ * @param resolution The resolution of the map.
+ * @param origin The common origin of the rays. See raycastHeightMap.
+ * @param ends The end points of the rays.
+ * @param pool An optional thread pool used to process the batches concurrently.
+ * @param batch_size The number of rays per batch.
+ * @return The result of each ray in the same order as the end points.
+ */
+template<typename Scalar>
+std::vector<RaycastResult<Scalar>>
+raycastHeightMap( const GridMap<Scalar> &map, Scalar resolution, const Vector3<Scalar> &origin,
+                  const Vector3List<Scalar> &ends, ThreadPool *pool = nullptr,
+                  std::size_t batch_size = 64 );
+
+template<typename Scalar>
+RaycastResult<Scalar> raycastHeightMap( const GridMap<Scalar> &map, Scalar resolution,
+                                        const Vector3<Scalar> &origin, const Vector3<Scalar> &end )
+{
+  RaycastResult<Scalar> result;
+  const Vector2<double> start_index =
+      origin.template head<2>().template cast<double>() / double( resolution );
+  const Vector2<double> end_index =
+      end.template head<2>().template cast<double>() / double( resolution );
+  const Vector2<double> direction = end_index - start_index;
+  const double start_z = origin.z();
+  const double delta_z = double( end.z() ) - start_z;
+  auto check_cell = [&]( Eigen::Index x, Eigen::Index y ) {
+    const Scalar height = map( x, y );
+    if ( std::isnan( height ) )
+      return true; // Unknown cells are never hit
+    // Compute the parameter range [t_enter, t_exit] of the ray inside the cell
+    double t_enter = 0;
+    double t_exit = 1;
+    for ( int axis = 0; axis < 2; ++axis ) {
+      if ( direction[axis] == 0 )
+        continue;
+      const Eigen::Index index = axis == 0 ? x : y;
+      double t0 = ( double( index ) - start_index[axis] ) / direction[axis];
+      double t1 = ( double( index + 1 ) - start_index[axis] ) / direction[axis];
+      if ( t0 > t1 )
+        std::swap( t0, t1 );
+      t_enter = std::max( t_enter, t0 );
+      t_exit = std::min( t_exit, t1 );
+    }
+    if ( height < start_z + std::min( t_enter * delta_z, t_exit * delta_z ) )
+      return true;
+    result.x = x;
+    result.y = y;
+    result.range = t_enter * ( end - origin ).norm();
+    result.hit = true;
+    return false;
+  };
+  iterateLineSupercover( start_index, end_index, map.rows(), map.cols(), check_cell );
+  return result;
+}
+
+template<typename Scalar>
+std::vector<RaycastResult<Scalar>>
+raycastHeightMap( const GridMap<Scalar> &map, Scalar resolution, const Vector3<Scalar> &origin,
+                  const Vector3List<Scalar> &ends, ThreadPool *pool, std::size_t batch_size )
+{
+  std::vector<RaycastResult<Scalar>> results( ends.size() );
+  if ( ends.empty() )
+    return results;
+  batch_size = std::max<std::size_t>( 1, batch_size );
+  // Sort the rays by their direction such that the rays in a batch are neighbors
+  std::vector<Scalar> angles( ends.size() );
+  for ( std::size_t i = 0; i < ends.size(); ++i )
+    angles[i] = std::atan2( ends[i].y() - origin.y(), ends[i].x() - origin.x() );
+  std::vector<std::size_t> order( ends.size() );
+  std::iota( order.begin(), order.end(), 0 );
+  std::sort( order.begin(), order.end(),
+             [&angles]( std::size_t a, std::size_t b ) { return angles[a] < angles[b]; } );
+
+  auto process_batch = [&]( std::size_t first, std::size_t last ) {
+    for ( std::size_t i = first; i < last; ++i ) {
+      const std::size_t index = order[i];
+      results[index] = raycastHeightMap( map, resolution, origin, ends[index] );
+    }
+  };
+  if ( pool == nullptr ) {
+    process_batch( 0, order.size() );
+    return results;
+  }
+  std::vector<std::future<void>> futures;
+  futures.reserve( ( order.size() + batch_size - 1 ) / batch_size );
+  for ( std::size_t first = 0; first < order.size(); first += batch_size ) {
+    const std::size_t last = std::min( first + batch_size, order.size() );
+    futures.push_back(
+        pool->enqueue( [&process_batch, first, last]() { process_batch( first, last ); } ) );
+  }
+  // Wait for all batches before rethrowing any exception since they reference local variables
+  for ( auto &future : futures ) future.wait();
+  for ( auto &future : futures ) future.get();
+  return results;
+}
+} // namespace hector_math
+
+#endif // HECTOR_MATH_RAYCAST_H
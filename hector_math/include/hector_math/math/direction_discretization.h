@@ -39,6 +39,11 @@ constexpr int decrementDirection( int direction ) noexcept;
 template<int DIRECTIONS, typename Scalar>
 constexpr Scalar directionFromAngle( Scalar angle ) noexcept;
 
+//! @see directionFromAngle
+//! @return The direction for the given angle (in rad) as a scalar as it may lie between two direction increments.
+template<typename Scalar>
+constexpr Scalar directionFromAngle( Scalar angle, int directions ) noexcept;
+
 //! This method only uses the rotation part around the z-axis of the quaternion. @see directionFromAngle
 //! @return The direction for the given quaternion as a scalar as it may lie between two direction increments.
 template<int DIRECTIONS, typename Scalar>
@@ -135,6 +140,13 @@ constexpr Scalar directionFromAngle( Scalar angle ) noexcept
   return angle * multiplier;
 }
 
+template<typename Scalar>
+constexpr Scalar directionFromAngle( Scalar angle, int directions ) noexcept
+{
+  const Scalar multiplier = directions / Scalar( 2 * M_PI );
+  return angle * multiplier;
+}
+
 template<int DIRECTIONS, typename Scalar>
 constexpr Scalar directionFromQuaternion( const Eigen::Quaternion<Scalar> &q )
 {
@@ -0,0 +1,101 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_THREAD_POOL_H
+#define HECTOR_MATH_THREAD_POOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * A simple fixed size pool of worker threads that execute enqueued tasks in FIFO order.
+ * The pool is used by the parallel variants of the iterators and map operations. It can (and
+ * should) be reused for multiple calls since starting threads is comparatively expensive.
+ *
+ * The threads are joined on destruction after all enqueued tasks were executed.
+ */
+class ThreadPool
+{
+public:
+  /*!
+   * @param threads The number of worker threads. If 0, the number of concurrent threads supported
+   *   by the hardware is used.
+   */
+  explicit ThreadPool( unsigned int threads = 0 )
+  {
+    if ( threads == 0 )
+      threads = std::max( 1U, std::thread::hardware_concurrency() );
+    workers_.reserve( threads );
+    for ( unsigned int i = 0; i < threads; ++i ) workers_.emplace_back( [this]() { work(); } );
+  }
+
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for ( auto &worker : workers_ ) worker.join();
+  }
+
+  ThreadPool( const ThreadPool & ) = delete;
+  ThreadPool &operator=( const ThreadPool & ) = delete;
+
+  //! @return The number of worker threads in this pool.
+  std::size_t size() const { return workers_.size(); }
+
+  /*!
+   * Enqueues the given task for execution on one of the worker threads.
+   * @param task A function or lambda method with the signature: void().
+   * @return A future that becomes ready once the task was executed. Exceptions thrown by the task
+   *   are rethrown when calling get on the future.
+   */
+  template<typename Task>
+  std::future<void> enqueue( Task task )
+  {
+    auto packaged_task = std::make_shared<std::packaged_task<void()>>( std::move( task ) );
+    std::future<void> result = packaged_task->get_future();
+    {
+      std::lock_guard<std::mutex> lock( mutex_ );
+      tasks_.emplace( [packaged_task]() { ( *packaged_task )(); } );
+    }
+    condition_.notify_one();
+    return result;
+  }
+
+private:
+  void work()
+  {
+    while ( true ) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock( mutex_ );
+        condition_.wait( lock, [this]() { return stop_ || !tasks_.empty(); } );
+        if ( tasks_.empty() )
+          return; // Only happens if stop_ is true
+        task = std::move( tasks_.front() );
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_ = false;
+};
+} // namespace hector_math
+
+#endif // HECTOR_MATH_THREAD_POOL_H
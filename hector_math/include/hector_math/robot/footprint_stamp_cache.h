@@ -0,0 +1,169 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HECTOR_MATH_FOOTPRINT_STAMP_CACHE_H
+#define HECTOR_MATH_FOOTPRINT_STAMP_CACHE_H
+
+#include "hector_math/iterators/polygon_raster_plan.h"
+#include "hector_math/map_operations/find_minmax.h"
+#include "hector_math/math/direction_discretization.h"
+#include "hector_math/types.h"
+#include <vector>
+
+namespace hector_math
+{
+
+/*!
+ * Precomputes the rasterized footprint of a robot for a number of discrete orientations and
+ * sub-cell offsets. Looking up the footprint for a pose is then a table lookup and the cells can
+ * be iterated using the precomputed runs (see PolygonRasterPlan) instead of rotating and
+ * rasterizing the footprint polygon for every pose.
+ *
+ * The orientation is discretized as in direction_discretization.h, i.e., direction 0 points in
+ * positive x-direction and directions are equidistant angles counter-clockwise.
+ * The position is discretized by splitting each cell into subdivisions x subdivisions sub-cells.
+ * Hence, the iterated cells are the cells of the footprint at the nearest discrete orientation
+ * and at the center of the sub-cell the position lies in.
+ */
+template<typename Scalar>
+class FootprintStampCache
+{
+public:
+  /*!
+   * @param footprint The footprint polygon in the robot frame in map coordinates (e.g. meters).
+   * @param resolution The resolution of the maps this footprint is evaluated on.
+   * @param directions The number of discrete orientations the footprint is precomputed for.
+   * @param subdivisions The number of sub-cell offsets per axis the footprint is precomputed for.
+   */
+  FootprintStampCache( const Polygon<Scalar> &footprint, Scalar resolution, int directions = 32,
+                       int subdivisions = 4 )
+      : resolution_( resolution ), directions_( directions ), subdivisions_( subdivisions )
+  {
+    if ( directions_ < 1 || subdivisions_ < 1 )
+      throw std::invalid_argument(
+          "FootprintStampCache: directions and subdivisions have to be at least 1!" );
+    stamps_.reserve( directions_ * subdivisions_ * subdivisions_ );
+    for ( int direction = 0; direction < directions_; ++direction ) {
+      const Eigen::Rotation2D<Scalar> rotation(
+          angleFromDirection<Scalar>( direction, directions_ ) );
+      const Polygon<Scalar> rotated = ( rotation.toRotationMatrix() * footprint.matrix() ).array() /
+                                      resolution_;
+      for ( int sub_y = 0; sub_y < subdivisions_; ++sub_y ) {
+        for ( int sub_x = 0; sub_x < subdivisions_; ++sub_x ) {
+          const Point<Scalar> offset( ( sub_x + Scalar( 0.5 ) ) / subdivisions_,
+                                      ( sub_y + Scalar( 0.5 ) ) / subdivisions_ );
+          stamps_.emplace_back( Polygon<Scalar>( rotated.colwise() + offset ) );
+        }
+      }
+    }
+  }
+
+  Scalar resolution() const { return resolution_; }
+
+  int directions() const { return directions_; }
+
+  int subdivisions() const { return subdivisions_; }
+
+  //! @return The rasterized footprint for the given discrete direction and sub-cell offset relative
+  //!   to the cell the position lies in.
+  const PolygonRasterPlan &stamp( int direction, int sub_x, int sub_y ) const
+  {
+    assert( 0 <= direction && direction < directions_ && 0 <= sub_x && sub_x < subdivisions_ &&
+            0 <= sub_y && sub_y < subdivisions_ && "FootprintStampCache: Index out of bounds!" );
+    return stamps_[( direction * subdivisions_ + sub_y ) * subdivisions_ + sub_x];
+  }
+
+  /*!
+   * Iterates over the runs of cells of the footprint at the given pose.
+   * The indexes can be limited using the ranges [row_min, row_max) and [col_min, col_max).
+   * @see iteratePolygonSpans
+   *
+   * @tparam Functor A function or lambda method with the signature:
+   *   void(Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end).
+   * @param pos The position of the robot in map coordinates relative to the corner of the cell
+   *   (0, 0), i.e., pos / resolution is in the index space of the map.
+   * @param orientation The orientation (yaw angle in rad) of the robot.
+   * @return False if the iteration was stopped by the functor returning false, true otherwise.
+   */
+  template<typename Functor>
+  bool iterateSpans( const Vector2<Scalar> &pos, Scalar orientation, Eigen::Index row_min,
+                     Eigen::Index row_max, Eigen::Index col_min, Eigen::Index col_max,
+                     Functor functor ) const
+  {
+    const Vector2<Scalar> index_pos = pos / resolution_;
+    const Scalar floor_x = std::floor( index_pos.x() );
+    const Scalar floor_y = std::floor( index_pos.y() );
+    const int sub_x =
+        std::min<int>( subdivisions_ - 1, ( index_pos.x() - floor_x ) * subdivisions_ );
+    const int sub_y =
+        std::min<int>( subdivisions_ - 1, ( index_pos.y() - floor_y ) * subdivisions_ );
+    return stamp( discreteDirection( orientation ), sub_x, sub_y )
+        .iterateSpans( static_cast<Eigen::Index>( floor_x ), static_cast<Eigen::Index>( floor_y ),
+                       row_min, row_max, col_min, col_max, functor );
+  }
+
+  //! Overload of iterateSpans where row_min and col_min are set to 0 to allow for bounded
+  //! iteration of 2D matrices and arrays.
+  template<typename Functor>
+  bool iterateSpans( const Vector2<Scalar> &pos, Scalar orientation, Eigen::Index rows,
+                     Eigen::Index cols, Functor functor ) const
+  {
+    return iterateSpans( pos, orientation, 0, rows, 0, cols, functor );
+  }
+
+  /*!
+   * Iterates over all cells of the footprint at the given pose.
+   * @tparam Functor A function or lambda method with the signature:
+   *   void(Eigen::Index x, Eigen::Index y) or bool(Eigen::Index x, Eigen::Index y) to stop early.
+   * @see iterateSpans
+   */
+  template<typename Functor>
+  bool iterate( const Vector2<Scalar> &pos, Scalar orientation, Eigen::Index rows,
+                Eigen::Index cols, Functor functor ) const
+  {
+    return iterateSpans( pos, orientation, 0, rows, 0, cols,
+                         [&functor]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                           return detail::iterateSpanCells( functor, y, x_start, x_end );
+                         } );
+  }
+
+  /*!
+   * Computes the minimum value of the map inside the footprint at the given pose.
+   * This method is robust against NaN values in the map.
+   * As soon as a value smaller than maximum is found, the evaluation stops early and that value is
+   * returned since the caller is not interested in the exact minimum below this bound.
+   * Pass std::numeric_limits<Scalar>::lowest() to always obtain the exact minimum.
+   * @see RobotFootprint::getMinimum
+   */
+  Scalar getMinimum( const GridMap<Scalar> &map, const Vector2<Scalar> &pos, Scalar orientation,
+                     Scalar maximum ) const
+  {
+    Scalar minimum = impl::initialMinimum<Scalar>();
+    iterate( pos, orientation, map.rows(), map.cols(), [&]( Eigen::Index x, Eigen::Index y ) {
+      const Scalar &val = map( x, y );
+      if ( std::isnan( val ) || val >= minimum )
+        return true; // Will be false for NaN
+      minimum = val;
+      return minimum >= maximum; // Stop once the bound is beaten
+    } );
+    return minimum;
+  }
+
+  //! @return The discrete direction in [0, directions) nearest to the given orientation (in rad).
+  int discreteDirection( Scalar orientation ) const
+  {
+    int direction = static_cast<int>(
+        std::round( directionFromAngle<Scalar>( orientation, directions_ ) ) );
+    direction %= directions_;
+    return direction < 0 ? direction + directions_ : direction;
+  }
+
+private:
+  std::vector<PolygonRasterPlan> stamps_;
+  Scalar resolution_;
+  int directions_;
+  int subdivisions_;
+};
+} // namespace hector_math
+
+#endif // HECTOR_MATH_FOOTPRINT_STAMP_CACHE_H
@@ -4,8 +4,8 @@
 #ifndef HECTOR_MATH_FOOTPRINT_ACCESSOR_H
 #define HECTOR_MATH_FOOTPRINT_ACCESSOR_H
 
+#include "hector_math/robot/footprint_stamp_cache.h"
 #include "hector_math/types.h"
-#include <urdf_model/model.h>
 
 namespace hector_math
 {
@@ -14,9 +14,55 @@ template<typename Scalar>
 class RobotFootprint
 {
 public:
+  virtual ~RobotFootprint() = default;
+
+  /*!
+   * Computes the minimum value of the map inside the footprint of the robot at the given pose.
+   * @param map The map, e.g., an elevation map.
+   * @param pos The position of the robot in map coordinates relative to the corner of the cell
+   *   (0, 0), i.e., pos / resolution is in the index space of the map.
+   * @param orientation The orientation (yaw angle in rad) of the robot.
+   * @param maximum An upper bound for the minimum that is of interest to the caller. Implementations
+   *   may stop early once a value smaller than this bound is found and return that value instead
+   *   of the exact minimum.
+   * @return The minimum value or NaN if the footprint contains no non-NaN value of the map.
+   */
   virtual Scalar getMinimum( const GridMap<Scalar> &map, const Vector2<Scalar> &pos,
                              Scalar orientation, Scalar maximum ) const = 0;
 };
+
+/*!
+ * A robot footprint given by a polygon. The footprint is rasterized for discrete orientations and
+ * sub-cell offsets in advance using a FootprintStampCache, hence, evaluating a pose is a table
+ * lookup and an iteration over the precomputed runs of the stamp.
+ */
+template<typename Scalar>
+class PolygonRobotFootprint : public RobotFootprint<Scalar>
+{
+public:
+  /*!
+   * @param footprint The footprint polygon in the robot frame in map coordinates (e.g. meters).
+   * @param resolution The resolution of the maps this footprint is evaluated on.
+   * @param directions The number of discrete orientations the footprint is precomputed for.
+   * @param subdivisions The number of sub-cell offsets per axis the footprint is precomputed for.
+   */
+  PolygonRobotFootprint( const Polygon<Scalar> &footprint, Scalar resolution, int directions = 32,
+                         int subdivisions = 4 )
+      : stamps_( footprint, resolution, directions, subdivisions )
+  {
+  }
+
+  Scalar getMinimum( const GridMap<Scalar> &map, const Vector2<Scalar> &pos, Scalar orientation,
+                     Scalar maximum ) const override
+  {
+    return stamps_.getMinimum( map, pos, orientation, maximum );
+  }
+
+  const FootprintStampCache<Scalar> &stamps() const { return stamps_; }
+
+protected:
+  FootprintStampCache<Scalar> stamps_;
+};
 } // namespace hector_math
 
 #endif // HECTOR_MATH_FOOTPRINT_ACCESSOR_H
@@ -76,6 +76,10 @@ template<typename Scalar>
 using Polygon = Eigen::Array<Scalar, 2, Eigen::Dynamic>;
 using Polygonf = Polygon<float>;
 using Polygond = Polygon<double>;
+template<typename Scalar>
+using PolygonList = std::vector<Polygon<Scalar>>;
+using PolygonfList = PolygonList<float>;
+using PolygondList = PolygonList<double>;
 
 template<typename Scalar>
 using GridMap = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
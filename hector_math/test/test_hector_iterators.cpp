@@ -2,12 +2,29 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include "iterator_test_input.h"
+#include <hector_math/iterators/annulus_iterator.h>
+#include <hector_math/iterators/cell_range.h>
 #include <hector_math/iterators/circle_iterator.h>
+#include <hector_math/iterators/circle_stencil.h>
+#include <hector_math/iterators/ellipse_iterator.h>
+#include <hector_math/iterators/line_iterator.h>
+#include <hector_math/iterators/multi_polygon_iterator.h>
+#include <hector_math/iterators/parallel_iterators.h>
+#include <hector_math/iterators/polygon_coverage_iterator.h>
 #include <hector_math/iterators/polygon_iterator.h>
+#include <hector_math/iterators/polygon_outline_iterator.h>
+#include <hector_math/iterators/polygon_raster_plan.h>
 #include <hector_math/iterators/rectangle_iterator.h>
+#include <hector_math/iterators/sector_iterator.h>
+#include <hector_math/iterators/swept_polygon_iterator.h>
+#include <hector_math/iterators/tiled_iterator.h>
 
 #include "eigen_tests.h"
 #include <fstream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <thread>
 #include <gtest/gtest.h>
 using namespace hector_math;
 
@@ -570,6 +587,1339 @@ TYPED_TEST( IteratorTest, polygonTest )
                        offset, "TestCaseUShapeLimitedIndexes.txt" );
 }
 
+TYPED_TEST( IteratorTest, spanTest )
+{
+  using Scalar = TypeParam;
+  using Vector2S = Vector2<Scalar>;
+  GridMap<Eigen::Index> expected_map = GridMap<Eigen::Index>::Zero( 10, 10 );
+  GridMap<Eigen::Index> actual_map = GridMap<Eigen::Index>::Zero( 10, 10 );
+  auto cell_functor = [&expected_map]( Eigen::Index x, Eigen::Index y ) {
+    expected_map( x, y ) += 1;
+  };
+  auto span_functor = [&actual_map]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+    EXPECT_LT( x_start, x_end );
+    EXPECT_TRUE( x_start >= 0 and x_end <= actual_map.rows() and y >= 0 and
+                 y < actual_map.cols() );
+    actual_map.col( y ).segment( x_start, x_end - x_start ) += 1;
+  };
+
+  for ( PolygonTyp type : { PolygonTyp::RandomStructure, PolygonTyp::Z_Shape, PolygonTyp::Circle,
+                            PolygonTyp::U_Shape, PolygonTyp::Line } ) {
+    Polygon<Scalar> polygon = createPolygon<Scalar>( type );
+    expected_map.setZero();
+    actual_map.setZero();
+    iteratePolygon<Scalar>( polygon, 0, 10, 0, 10, cell_functor );
+    iteratePolygonSpans<Scalar>( polygon, 0, 10, 0, 10, span_functor );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) ) << "Polygon type " << type;
+
+    expected_map.setZero();
+    actual_map.setZero();
+    iteratePolygon<Scalar>( polygon, 1, 7, 2, 6, cell_functor );
+    iteratePolygonSpans<Scalar>( polygon, 1, 7, 2, 6, span_functor );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) )
+        << "Polygon type " << type << " with limited indexes";
+  }
+
+  expected_map.setZero();
+  actual_map.setZero();
+  iterateCircle<Scalar>( Vector2S( 4.3, 5.1 ), 3.7, 10, 10, cell_functor );
+  iterateCircleSpans<Scalar>( Vector2S( 4.3, 5.1 ), 3.7, 10, 10, span_functor );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) ) << "Circle";
+
+  expected_map.setZero();
+  actual_map.setZero();
+  iterateCircle<Scalar>( Vector2S( 2, 2 ), 4, 1, 5, 0, 3, cell_functor );
+  iterateCircleSpans<Scalar>( Vector2S( 2, 2 ), 4, 1, 5, 0, 3, span_functor );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) ) << "Circle with limited indexes";
+
+  expected_map.setZero();
+  actual_map.setZero();
+  iterateRectangle<Scalar>( Vector2S( 0.4, 0.4 ), Vector2S( 7.4, 3.6 ), Vector2S( 2.6, 9.4 ), 10,
+                            10, cell_functor );
+  iterateRectangleSpans<Scalar>( Vector2S( 0.4, 0.4 ), Vector2S( 7.4, 3.6 ),
+                                 Vector2S( 2.6, 9.4 ), 10, 10, span_functor );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) ) << "Rectangle";
+
+  expected_map.setZero();
+  actual_map.setZero();
+  iterateRectangle<Scalar>( Vector2S( 0.4, 0.4 ), Vector2S( 7.4, 3.6 ), Vector2S( 2.6, 9.4 ), 2, 5,
+                            1, 8, cell_functor );
+  iterateRectangleSpans<Scalar>( Vector2S( 0.4, 0.4 ), Vector2S( 7.4, 3.6 ),
+                                 Vector2S( 2.6, 9.4 ), 2, 5, 1, 8, span_functor );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) )
+      << "Rectangle with limited indexes";
+}
+
+namespace
+{
+//! Compares the fixed size polygon iteration with the iteration of the same dynamic polygon.
+template<typename Scalar, int N>
+void testFixedSizePolygon( std::mt19937 &gen )
+{
+  // Random star shaped polygon, i.e., vertices at increasing angles with a random radius
+  std::uniform_real_distribution<Scalar> radius_dist( 2, 7 );
+  std::uniform_real_distribution<Scalar> angle_dist( 0, 2 * M_PI / N );
+  std::uniform_real_distribution<Scalar> center_dist( 6, 14 );
+  Eigen::Array<Scalar, 2, N> polygon;
+  const Scalar center_x = center_dist( gen ), center_y = center_dist( gen );
+  for ( int i = 0; i < N; ++i ) {
+    const Scalar angle = Scalar( 2 * M_PI * i / N ) + angle_dist( gen );
+    const Scalar radius = radius_dist( gen );
+    polygon.col( i ) << center_x + radius * std::cos( angle ),
+        center_y + radius * std::sin( angle );
+  }
+  const Polygon<Scalar> dynamic_polygon = polygon;
+
+  GridMap<Eigen::Index> expected_map = GridMap<Eigen::Index>::Zero( 20, 20 );
+  GridMap<Eigen::Index> actual_map = GridMap<Eigen::Index>::Zero( 20, 20 );
+  iteratePolygon<Scalar>( dynamic_polygon, 20, 20,
+                          [&]( Eigen::Index x, Eigen::Index y ) { expected_map( x, y ) += 1; } );
+  EXPECT_TRUE( iteratePolygon(
+      polygon, 20, 20, [&]( Eigen::Index x, Eigen::Index y ) { actual_map( x, y ) += 1; } ) );
+  EXPECT_GT( expected_map.sum(), 0 ) << N << "-gon";
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) ) << N << "-gon";
+
+  actual_map.setZero();
+  iteratePolygonSpans( polygon, 20, 20,
+                       [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+                         actual_map.col( y ).segment( x_start, x_end - x_start ) += 1;
+                       } );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) ) << N << "-gon spans";
+
+  expected_map.setZero();
+  actual_map.setZero();
+  iteratePolygon<Scalar>( dynamic_polygon, 3, 11, 5, 13,
+                          [&]( Eigen::Index x, Eigen::Index y ) { expected_map( x, y ) += 1; } );
+  iteratePolygon( polygon, 3, 11, 5, 13,
+                  [&]( Eigen::Index x, Eigen::Index y ) { actual_map( x, y ) += 1; } );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) ) << N << "-gon with limited indexes";
+
+  int count = 0;
+  EXPECT_FALSE(
+      iteratePolygon( polygon, [&]( Eigen::Index, Eigen::Index ) { return ++count < 3; } ) );
+  EXPECT_EQ( count, 3 ) << N << "-gon";
+}
+} // namespace
+
+TYPED_TEST( IteratorTest, fixedSizePolygonTest )
+{
+  using Scalar = TypeParam;
+  std::mt19937 gen( 42 );
+  for ( int i = 0; i < 20; ++i ) {
+    testFixedSizePolygon<Scalar, 3>( gen );
+    testFixedSizePolygon<Scalar, 4>( gen );
+    testFixedSizePolygon<Scalar, 6>( gen );
+    testFixedSizePolygon<Scalar, 8>( gen );
+    testFixedSizePolygon<Scalar, 20>( gen );
+  }
+
+  // Also accepts the fixed size polygons with an explicit scalar type
+  Eigen::Array<Scalar, 2, 4> square;
+  square << 1.2, 4.8, 4.8, 1.2, 1.3, 1.3, 3.7, 3.7;
+  int count = 0;
+  iteratePolygon<Scalar>( square, 10, 10, [&]( Eigen::Index x, Eigen::Index y ) {
+    EXPECT_TRUE( x >= 1 and x < 5 and y >= 1 and y < 4 ) << x << ", " << y;
+    ++count;
+  } );
+  EXPECT_EQ( count, 4 * 3 );
+
+  // The inlined rounding is equivalent to std::round
+  for ( double value : { -2.5, -1.5, -0.5, -0.49999999999999994, 0.0, 0.49999999999999994, 0.5, 1.5,
+                         2.5, 3.2, -3.7, 1E6 + 0.5, -1E6 - 0.5 } ) {
+    EXPECT_EQ( detail::roundToIndex( value ), static_cast<Eigen::Index>( std::round( value ) ) )
+        << value;
+  }
+
+  // Degenerate polygons do not contain any cells
+  Eigen::Array<Scalar, 2, 2> line;
+  line << 0, 5, 0, 5;
+  iteratePolygon( line, [&]( Eigen::Index, Eigen::Index ) { ++count; } );
+  EXPECT_EQ( count, 4 * 3 );
+}
+
+TYPED_TEST( IteratorTest, polygonRasterPlanTest )
+{
+  using Scalar = TypeParam;
+  GridMap<Eigen::Index> expected_map( 20, 20 );
+  GridMap<Eigen::Index> actual_map( 20, 20 );
+  // Only non-negative offsets are used since std::round breaks ties (cell centers exactly on the
+  // boundary) away from zero, hence, translating such a polygon into negative indexes is not exact.
+  for ( PolygonTyp type : { PolygonTyp::RandomStructure, PolygonTyp::Z_Shape, PolygonTyp::Circle,
+                            PolygonTyp::U_Shape, PolygonTyp::Line } ) {
+    Polygon<Scalar> polygon = createPolygon<Scalar>( type );
+    PolygonRasterPlan plan( polygon );
+    EXPECT_EQ( plan.empty(), type == PolygonTyp::Line );
+    for ( Eigen::Index x_offset : { 0, 3, 12 } ) {
+      for ( Eigen::Index y_offset : { 0, 5, 14 } ) {
+        Polygon<Scalar> translated = polygon;
+        translated.colwise() += Point<Scalar>( x_offset, y_offset );
+        expected_map.setZero();
+        actual_map.setZero();
+        iteratePolygon<Scalar>( translated, 20, 20,
+                                [&expected_map]( Eigen::Index x, Eigen::Index y ) {
+                                  expected_map( x, y ) += 1;
+                                } );
+        plan.iterate( x_offset, y_offset, 20, 20, [&actual_map]( Eigen::Index x, Eigen::Index y ) {
+          EXPECT_TRUE( x >= 0 and x < actual_map.rows() and y >= 0 and y < actual_map.cols() );
+          actual_map( x, y ) += 1;
+        } );
+        EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) )
+            << "Polygon type " << type << " with offset " << x_offset << ", " << y_offset;
+
+        expected_map.setZero();
+        actual_map.setZero();
+        iteratePolygon<Scalar>( translated, 2, 9, 4, 11,
+                                [&expected_map]( Eigen::Index x, Eigen::Index y ) {
+                                  expected_map( x, y ) += 1;
+                                } );
+        plan.iterateSpans(
+            x_offset, y_offset, 2, 9, 4, 11,
+            [&actual_map]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+              EXPECT_TRUE( x_start >= 2 and x_end <= 9 and y >= 4 and y < 11 );
+              actual_map.col( y ).segment( x_start, x_end - x_start ) += 1;
+            } );
+        EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) )
+            << "Polygon type " << type << " with offset " << x_offset << ", " << y_offset
+            << " and limited indexes";
+      }
+    }
+  }
+}
+
+TYPED_TEST( IteratorTest, earlyTerminationTest )
+{
+  using Scalar = TypeParam;
+  using Vector2S = Vector2<Scalar>;
+  Polygon<Scalar> polygon = createPolygon<Scalar>( PolygonTyp::RandomStructure );
+  Eigen::Index total = 0;
+  EXPECT_TRUE( iteratePolygon<Scalar>( polygon, 10, 10,
+                                       [&total]( Eigen::Index, Eigen::Index ) { ++total; } ) );
+  ASSERT_GT( total, 5 );
+
+  // Functors returning bool that never stop visit the same cells
+  Eigen::Index count = 0;
+  EXPECT_TRUE( iteratePolygon<Scalar>( polygon, 10, 10, [&count]( Eigen::Index, Eigen::Index ) {
+    ++count;
+    return true;
+  } ) );
+  EXPECT_EQ( count, total );
+
+  auto stop_after = []( Eigen::Index &count, Eigen::Index limit ) {
+    return [&count, limit]( Eigen::Index, Eigen::Index ) { return ++count < limit; };
+  };
+  count = 0;
+  EXPECT_FALSE( iteratePolygon<Scalar>( polygon, 10, 10, stop_after( count, 5 ) ) );
+  EXPECT_EQ( count, 5 );
+  count = 0;
+  EXPECT_FALSE(
+      iterateCircle<Scalar>( Vector2S( 4.3, 5.1 ), 3.7, 10, 10, stop_after( count, 3 ) ) );
+  EXPECT_EQ( count, 3 );
+  count = 0;
+  EXPECT_FALSE( iterateRectangle<Scalar>( Vector2S( 0.4, 0.4 ), Vector2S( 7.4, 3.6 ),
+                                          Vector2S( 2.6, 9.4 ), 10, 10, stop_after( count, 7 ) ) );
+  EXPECT_EQ( count, 7 );
+  count = 0;
+  PolygonRasterPlan plan( polygon );
+  EXPECT_FALSE( plan.iterate( 2, 3, 20, 20, stop_after( count, 4 ) ) );
+  EXPECT_EQ( count, 4 );
+
+  // Span functors stop after the first run
+  Eigen::Index runs = 0;
+  auto first_run_only = [&runs]( Eigen::Index, Eigen::Index, Eigen::Index ) {
+    ++runs;
+    return false;
+  };
+  EXPECT_FALSE( iteratePolygonSpans<Scalar>( polygon, 10, 10, first_run_only ) );
+  EXPECT_FALSE( iterateCircleSpans<Scalar>( Vector2S( 4.3, 5.1 ), 3.7, 10, 10, first_run_only ) );
+  EXPECT_FALSE( iterateRectangleSpans<Scalar>( Vector2S( 0.4, 0.4 ), Vector2S( 7.4, 3.6 ),
+                                               Vector2S( 2.6, 9.4 ), 10, 10, first_run_only ) );
+  EXPECT_EQ( runs, 3 );
+
+  // Shapes without any cell are never stopped
+  EXPECT_TRUE( iterateCircle<Scalar>( Vector2S( -5, -5 ), 1, 10, 10, stop_after( count, 0 ) ) );
+}
+
+TYPED_TEST( IteratorTest, polygonCoverageTest )
+{
+  using Scalar = TypeParam;
+  GridMap<double> coverage_map( 20, 20 );
+  for ( PolygonTyp type : { PolygonTyp::RandomStructure, PolygonTyp::Z_Shape, PolygonTyp::Circle,
+                            PolygonTyp::U_Shape, PolygonTyp::Line } ) {
+    Polygon<Scalar> polygon = createPolygon<Scalar>( type );
+    polygon.colwise() += Point<Scalar>( 3.3, 4.2 );
+    // Area of the polygon using the shoelace formula
+    double area = 0;
+    for ( Eigen::Index i = 0; i < polygon.cols(); ++i ) {
+      const Eigen::Index j = ( i + 1 ) % polygon.cols();
+      area += double( polygon( 0, i ) ) * polygon( 1, j ) -
+              double( polygon( 0, j ) ) * polygon( 1, i );
+    }
+    area = std::abs( area ) / 2;
+
+    coverage_map.setZero();
+    Eigen::Index last_x = -1, last_y = -1;
+    EXPECT_TRUE( iteratePolygonCoverage<Scalar>(
+        polygon, 20, 20, [&]( Eigen::Index x, Eigen::Index y, Scalar coverage ) {
+          EXPECT_TRUE( x >= 0 and x < 20 and y >= 0 and y < 20 );
+          EXPECT_TRUE( y > last_y || ( y == last_y && x > last_x ) ) << "Cells out of order";
+          last_x = x;
+          last_y = y;
+          EXPECT_GT( coverage, 0 );
+          EXPECT_LE( coverage, 1 );
+          coverage_map( x, y ) += coverage;
+        } ) );
+    EXPECT_NEAR( coverage_map.sum(), area, 1E-4 ) << "Polygon type " << type;
+
+    // Compare with a supersampled rasterization
+    constexpr int samples = 32;
+    GridMap<double> supersampled = GridMap<double>::Zero( 20 * samples, 20 * samples );
+    Polygon<Scalar> scaled = polygon * Scalar( samples );
+    iteratePolygon<Scalar>( scaled, 20 * samples, 20 * samples,
+                            [&supersampled]( Eigen::Index x, Eigen::Index y ) {
+                              supersampled( x, y ) = 1;
+                            } );
+    for ( Eigen::Index y = 0; y < 20; ++y ) {
+      for ( Eigen::Index x = 0; x < 20; ++x ) {
+        const double expected =
+            supersampled.block( x * samples, y * samples, samples, samples ).sum() /
+            ( samples * samples );
+        EXPECT_NEAR( coverage_map( x, y ), expected, 0.07 )
+            << "Polygon type " << type << " at " << x << ", " << y;
+      }
+    }
+
+    // Every cell visited by iteratePolygon is covered and interior cells are fully covered
+    iteratePolygon<Scalar>( polygon, 20, 20, [&]( Eigen::Index x, Eigen::Index y ) {
+      EXPECT_GT( coverage_map( x, y ), 0 );
+    } );
+
+    // Limited indexes report the same coverage for the cells inside the limits
+    GridMap<double> limited_map = GridMap<double>::Zero( 20, 20 );
+    iteratePolygonCoverage<Scalar>( polygon, 5, 9, 6, 10,
+                                    [&]( Eigen::Index x, Eigen::Index y, Scalar coverage ) {
+                                      EXPECT_TRUE( x >= 5 and x < 9 and y >= 6 and y < 10 );
+                                      limited_map( x, y ) += coverage;
+                                    } );
+    EXPECT_LT( ( limited_map - coverage_map ).block( 5, 6, 4, 4 ).abs().maxCoeff(), 1E-6 )
+        << "Polygon type " << type << " with limited indexes";
+
+    // Completely covered runs are passed to the span functor, the coverage of the cells is the same
+    GridMap<double> span_map = GridMap<double>::Zero( 20, 20 );
+    last_x = -1;
+    last_y = -1;
+    EXPECT_TRUE( iteratePolygonCoverage<Scalar>(
+        polygon, 20, 20,
+        [&]( Eigen::Index x, Eigen::Index y, Scalar coverage ) {
+          EXPECT_TRUE( y > last_y || ( y == last_y && x > last_x ) ) << "Cells out of order";
+          last_x = x;
+          last_y = y;
+          EXPECT_EQ( span_map( x, y ), 0 );
+          span_map( x, y ) += coverage;
+        },
+        [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+          EXPECT_TRUE( y > last_y || ( y == last_y && x_start > last_x ) ) << "Runs out of order";
+          EXPECT_LT( x_start, x_end );
+          last_x = x_end - 1;
+          last_y = y;
+          EXPECT_EQ( span_map.col( y ).segment( x_start, x_end - x_start ).abs().maxCoeff(), 0 );
+          span_map.col( y ).segment( x_start, x_end - x_start ) += 1;
+        } ) );
+    EXPECT_LT( ( span_map - coverage_map ).abs().maxCoeff(), 1E-6 ) << "Polygon type " << type;
+  }
+
+  // The interior of a large polygon is passed as runs
+  Polygon<Scalar> large( 2, 4 );
+  large.col( 0 ) << 10.5, 10.5;
+  large.col( 1 ) << 190.2, 30.7;
+  large.col( 2 ) << 170.5, 180.5;
+  large.col( 3 ) << 20.3, 150.1;
+  double large_sum = 0;
+  Eigen::Index cell_calls = 0, span_calls = 0, span_cells = 0;
+  iteratePolygonCoverage<Scalar>(
+      large,
+      [&]( Eigen::Index, Eigen::Index, Scalar coverage ) {
+        ++cell_calls;
+        large_sum += coverage;
+      },
+      [&]( Eigen::Index, Eigen::Index x_start, Eigen::Index x_end ) {
+        ++span_calls;
+        span_cells += x_end - x_start;
+        large_sum += x_end - x_start;
+      } );
+  double large_area = 0;
+  for ( Eigen::Index i = 0; i < large.cols(); ++i ) {
+    const Eigen::Index j = ( i + 1 ) % large.cols();
+    large_area += double( large( 0, i ) ) * large( 1, j ) - double( large( 0, j ) ) * large( 1, i );
+  }
+  EXPECT_NEAR( large_sum, std::abs( large_area ) / 2, 1E-2 );
+  EXPECT_LE( span_calls, 171 );
+  EXPECT_LT( cell_calls, 2000 );
+  EXPECT_GT( span_cells, 10 * cell_calls );
+
+  // Axis aligned square covering parts of cells
+  Polygon<Scalar> square( 2, 4 );
+  square.col( 0 ) << 1.25, 1.5;
+  square.col( 1 ) << 3.75, 1.5;
+  square.col( 2 ) << 3.75, 3;
+  square.col( 3 ) << 1.25, 3;
+  coverage_map.setZero();
+  iteratePolygonCoverage<Scalar>( square, [&]( Eigen::Index x, Eigen::Index y, Scalar coverage ) {
+    coverage_map( x, y ) += coverage;
+  } );
+  EXPECT_NEAR( coverage_map( 1, 1 ), 0.375, 1E-6 );
+  EXPECT_NEAR( coverage_map( 2, 1 ), 0.5, 1E-6 );
+  EXPECT_NEAR( coverage_map( 3, 1 ), 0.375, 1E-6 );
+  EXPECT_NEAR( coverage_map( 1, 2 ), 0.75, 1E-6 );
+  EXPECT_DOUBLE_EQ( coverage_map( 2, 2 ), 1 );
+  EXPECT_NEAR( coverage_map( 3, 2 ), 0.75, 1E-6 );
+  EXPECT_DOUBLE_EQ( coverage_map.sum(), 2.5 * 1.5 );
+}
+
+namespace
+{
+using Cells = std::vector<std::pair<Eigen::Index, Eigen::Index>>;
+
+//! Checks whether the segment from start to end intersects the cell (x, y) using Liang-Barsky.
+template<typename Scalar>
+bool segmentIntersectsCell( const Vector2<Scalar> &start, const Vector2<Scalar> &end,
+                            Eigen::Index x, Eigen::Index y )
+{
+  double t_min = 0, t_max = 1;
+  return detail::clipLineAxis( start.x(), double( end.x() ) - start.x(), x, x + 1, t_min, t_max ) &&
+         detail::clipLineAxis( start.y(), double( end.y() ) - start.y(), y, y + 1, t_min, t_max );
+}
+} // namespace
+
+TYPED_TEST( IteratorTest, lineTest )
+{
+  using Scalar = TypeParam;
+  using Vector2S = Vector2<Scalar>;
+  Cells cells;
+  auto collect = [&cells]( Eigen::Index x, Eigen::Index y ) { cells.emplace_back( x, y ); };
+
+  // Bresenham
+  iterateLine<Scalar>( Vector2S( 1.2, 2.7 ), Vector2S( 5.9, 2.1 ), collect );
+  EXPECT_EQ( cells, Cells( { { 1, 2 }, { 2, 2 }, { 3, 2 }, { 4, 2 }, { 5, 2 } } ) );
+  cells.clear();
+  iterateLine<Scalar>( Vector2S( 3.5, 3.5 ), Vector2S( 3.1, -0.5 ), collect );
+  EXPECT_EQ( cells, Cells( { { 3, 3 }, { 3, 2 }, { 3, 1 }, { 3, 0 }, { 3, -1 } } ) );
+  cells.clear();
+  iterateLine<Scalar>( Vector2S( 0.5, 0.5 ), Vector2S( 6.5, 3.5 ), collect );
+  EXPECT_EQ( cells,
+             Cells( { { 0, 0 }, { 1, 1 }, { 2, 1 }, { 3, 2 }, { 4, 2 }, { 5, 3 }, { 6, 3 } } ) );
+  cells.clear();
+  iterateLine<Scalar>( Vector2S( 4.5, 4.5 ), Vector2S( 4.7, 4.2 ), collect );
+  EXPECT_EQ( cells, Cells( { { 4, 4 } } ) );
+  cells.clear();
+  iterateLine<Scalar>( Vector2S( 0.5, 0.5 ), Vector2S( 6.5, 3.5 ), 2, 5, 0, 3, collect );
+  EXPECT_EQ( cells, Cells( { { 2, 1 }, { 3, 2 }, { 4, 2 } } ) );
+
+  // Supercover through corners visits both neighbors before the diagonal cell
+  cells.clear();
+  iterateLineSupercover<Scalar>( Vector2S( 0.5, 0.5 ), Vector2S( 2.5, 2.5 ), collect );
+  EXPECT_EQ( cells,
+             Cells( { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 }, { 2, 1 }, { 1, 2 }, { 2, 2 } } ) );
+
+  // Supercover visits exactly the cells intersected by the segment as a 4-connected path
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<double> dist( -5, 25 );
+  for ( int i = 0; i < 200; ++i ) {
+    const Vector2S start( dist( gen ), dist( gen ) );
+    const Vector2S end( dist( gen ), dist( gen ) );
+    cells.clear();
+    EXPECT_TRUE( iterateLineSupercover<Scalar>( start, end, collect ) );
+    ASSERT_FALSE( cells.empty() );
+    EXPECT_EQ( cells.front().first, Eigen::Index( std::floor( start.x() ) ) );
+    EXPECT_EQ( cells.front().second, Eigen::Index( std::floor( start.y() ) ) );
+    EXPECT_EQ( cells.back().first, Eigen::Index( std::floor( end.x() ) ) );
+    EXPECT_EQ( cells.back().second, Eigen::Index( std::floor( end.y() ) ) );
+    for ( size_t k = 1; k < cells.size(); ++k ) {
+      EXPECT_EQ( std::abs( cells[k].first - cells[k - 1].first ) +
+                     std::abs( cells[k].second - cells[k - 1].second ),
+                 1 );
+    }
+    Cells expected;
+    for ( Eigen::Index y = std::floor( std::min( start.y(), end.y() ) );
+          y <= std::floor( std::max( start.y(), end.y() ) ); ++y ) {
+      for ( Eigen::Index x = std::floor( std::min( start.x(), end.x() ) );
+            x <= std::floor( std::max( start.x(), end.x() ) ); ++x ) {
+        if ( segmentIntersectsCell( start, end, x, y ) )
+          expected.emplace_back( x, y );
+      }
+    }
+    Cells sorted = cells;
+    std::sort( sorted.begin(), sorted.end(), []( const auto &a, const auto &b ) {
+      return a.second < b.second || ( a.second == b.second && a.first < b.first );
+    } );
+    EXPECT_EQ( sorted, expected ) << "Line from " << start.transpose() << " to " << end.transpose();
+
+    // Bounded iteration visits the subset of cells in the bounds
+    Cells bounded_expected, bounded_bresenham_expected;
+    for ( const auto &cell : cells ) {
+      if ( cell.first >= 2 && cell.first < 17 && cell.second >= 0 && cell.second < 12 )
+        bounded_expected.push_back( cell );
+    }
+    cells.clear();
+    iterateLineSupercover<Scalar>( start, end, 2, 17, 0, 12, collect );
+    EXPECT_EQ( cells, bounded_expected )
+        << "Line from " << start.transpose() << " to " << end.transpose() << " with limits";
+
+    cells.clear();
+    iterateLine<Scalar>( start, end, collect );
+    for ( const auto &cell : cells ) {
+      if ( cell.first >= 2 && cell.first < 17 && cell.second >= 0 && cell.second < 12 )
+        bounded_bresenham_expected.push_back( cell );
+    }
+    cells.clear();
+    iterateLine<Scalar>( start, end, 2, 17, 0, 12, collect );
+    EXPECT_EQ( cells, bounded_bresenham_expected );
+  }
+
+  // A long beam crossing a small map only visits the cells of the unclipped line in the map
+  const Vector2S beam_start( -20000.3, -3000.6 ), beam_end( 20000.8, 4000.1 );
+  for ( const auto &beam : { std::make_pair( beam_start, beam_end ),
+                             std::make_pair( beam_end, beam_start ) } ) {
+    Cells beam_expected;
+    iterateLine<Scalar>( beam.first, beam.second, [&]( Eigen::Index x, Eigen::Index y ) {
+      if ( x >= -8 && x < 12 && y >= 490 && y < 510 )
+        beam_expected.emplace_back( x, y );
+    } );
+    ASSERT_FALSE( beam_expected.empty() );
+    cells.clear();
+    iterateLine<Scalar>( beam.first, beam.second, -8, 12, 490, 510, collect );
+    EXPECT_EQ( cells, beam_expected );
+  }
+  cells.clear();
+  iterateLine<Scalar>( beam_start, beam_end, 0, 20, 0, 20, collect );
+  EXPECT_TRUE( cells.empty() );
+
+  // Lines with non-finite end points are not iterated
+  const Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+  const Scalar inf = std::numeric_limits<Scalar>::infinity();
+  cells.clear();
+  EXPECT_TRUE( iterateLine<Scalar>( Vector2S( nan, 1.5 ), Vector2S( 5.5, 3.5 ), collect ) );
+  EXPECT_TRUE( iterateLine<Scalar>( Vector2S( 1.5, 1.5 ), Vector2S( inf, 3.5 ), 10, 10, collect ) );
+  EXPECT_TRUE( iterateLineSupercover<Scalar>( Vector2S( 1.5, nan ), Vector2S( 5.5, 3.5 ), collect ) );
+  EXPECT_TRUE(
+      iterateLineSupercover<Scalar>( Vector2S( -inf, 1.5 ), Vector2S( 5.5, 3.5 ), 10, 10, collect ) );
+  EXPECT_TRUE( cells.empty() );
+
+  // Early termination
+  int count = 0;
+  EXPECT_FALSE( iterateLineSupercover<Scalar>( Vector2S( 0.5, 0.5 ), Vector2S( 9.5, 7.5 ),
+                                               [&count]( Eigen::Index, Eigen::Index ) {
+                                                 return ++count < 3;
+                                               } ) );
+  EXPECT_EQ( count, 3 );
+}
+
+namespace
+{
+//! Accumulates the visited cells by value to test that each band gets its own copy.
+struct CellCounter {
+  GridMap<Eigen::Index> map = GridMap<Eigen::Index>::Zero( 20, 20 );
+  Eigen::Index count = 0;
+
+  void operator()( Eigen::Index x, Eigen::Index y )
+  {
+    map( x, y ) += 1;
+    ++count;
+  }
+};
+} // namespace
+
+TYPED_TEST( IteratorTest, parallelTest )
+{
+  using Scalar = TypeParam;
+  using Vector2S = Vector2<Scalar>;
+  auto reduction = []( CellCounter &result, const CellCounter &band ) {
+    result.map += band.map;
+    result.count += band.count;
+  };
+  for ( unsigned int threads : { 1U, 3U, 8U } ) {
+    ThreadPool pool( threads );
+    for ( PolygonTyp type : { PolygonTyp::RandomStructure, PolygonTyp::Z_Shape, PolygonTyp::Circle,
+                              PolygonTyp::U_Shape, PolygonTyp::Line } ) {
+      Polygon<Scalar> polygon = createPolygon<Scalar>( type );
+      polygon.colwise() += Point<Scalar>( 3, 4 );
+      CellCounter expected;
+      iteratePolygon<Scalar>( polygon, 20, 20, std::ref( expected ) );
+      CellCounter actual = iteratePolygonParallel<Scalar>( pool, polygon, 20, 20, CellCounter(),
+                                                           reduction );
+      EXPECT_EQ( expected.count, actual.count ) << "Polygon type " << type;
+      EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected.map, actual.map ) )
+          << "Polygon type " << type << " with " << threads << " threads";
+
+      expected = CellCounter();
+      iteratePolygon<Scalar>( polygon, 2, 9, 5, 11, std::ref( expected ) );
+      actual =
+          iteratePolygonParallel<Scalar>( pool, polygon, 2, 9, 5, 11, CellCounter(), reduction );
+      EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected.map, actual.map ) )
+          << "Polygon type " << type << " with " << threads << " threads and limited indexes";
+    }
+
+    CellCounter expected;
+    iterateCircle<Scalar>( Vector2S( 9.3, 8.1 ), 7.7, 20, 20, std::ref( expected ) );
+    CellCounter actual = iterateCircleParallel<Scalar>( pool, Vector2S( 9.3, 8.1 ), 7.7, 20, 20,
+                                                        CellCounter(), reduction );
+    EXPECT_GT( actual.count, 0 );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected.map, actual.map ) )
+        << "Circle with " << threads << " threads";
+
+    expected = CellCounter();
+    iterateCircle<Scalar>( Vector2S( 9.3, 8.1 ), 7.7, 3, 12, 6, 9, std::ref( expected ) );
+    actual = iterateCircleParallel<Scalar>( pool, Vector2S( 9.3, 8.1 ), 7.7, 3, 12, 6, 9,
+                                            CellCounter(), reduction );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected.map, actual.map ) )
+        << "Circle with " << threads << " threads and limited indexes";
+
+    // Circle that does not intersect the bounds returns the prototype
+    actual = iterateCircleParallel<Scalar>( pool, Vector2S( -9, -9 ), 2, 20, 20, CellCounter(),
+                                            reduction );
+    EXPECT_EQ( actual.count, 0 );
+  }
+
+  // The worker of a single thread pool iterates a band while the calling thread iterates another
+  struct ThreadIds {
+    std::set<std::thread::id> ids;
+    void operator()( Eigen::Index, Eigen::Index ) { ids.insert( std::this_thread::get_id() ); }
+  };
+  ThreadPool single_pool( 1 );
+  const ThreadIds result = iterateCircleParallel<Scalar>(
+      single_pool, Vector2S( 9.3, 8.1 ), 7.7, 20, 20, ThreadIds(),
+      []( ThreadIds &result, const ThreadIds &band ) {
+        result.ids.insert( band.ids.begin(), band.ids.end() );
+      } );
+  EXPECT_EQ( result.ids.size(), 2U );
+  EXPECT_EQ( result.ids.count( std::this_thread::get_id() ), 1U );
+}
+
+TYPED_TEST( IteratorTest, multiPolygonTest )
+{
+  using Scalar = TypeParam;
+  // A single ring is equivalent to iteratePolygon for both fill rules
+  for ( PolygonTyp type : { PolygonTyp::RandomStructure, PolygonTyp::Z_Shape, PolygonTyp::Circle,
+                            PolygonTyp::U_Shape, PolygonTyp::Line } ) {
+    Polygon<Scalar> polygon = createPolygon<Scalar>( type );
+    polygon.colwise() += Point<Scalar>( 3.3, 4.2 );
+    CellCounter expected;
+    iteratePolygon<Scalar>( polygon, 20, 20, std::ref( expected ) );
+    for ( FillRule fill_rule : { FillRule::EvenOdd, FillRule::NonZero } ) {
+      CellCounter actual;
+      EXPECT_TRUE(
+          iterateMultiPolygon<Scalar>( { polygon }, fill_rule, 20, 20, std::ref( actual ) ) );
+      EXPECT_EQ( expected.count, actual.count ) << "Polygon type " << type;
+      EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected.map, actual.map ) ) << "Polygon type " << type;
+    }
+  }
+
+  auto rectangle = []( Scalar x0, Scalar y0, Scalar x1, Scalar y1 ) {
+    Polygon<Scalar> result( 2, 4 );
+    result.col( 0 ) << x0, y0;
+    result.col( 1 ) << x1, y0;
+    result.col( 2 ) << x1, y1;
+    result.col( 3 ) << x0, y1;
+    return result;
+  };
+  const Polygon<Scalar> outer = rectangle( 2.2, 1.8, 16.7, 17.3 );
+  const Polygon<Scalar> inner = rectangle( 6.1, 5.9, 11.6, 12.4 );
+  const Polygon<Scalar> inner_reversed = inner.rowwise().reverse();
+  const Polygon<Scalar> overlapping = rectangle( 9.3, 8.7, 18.8, 19.1 );
+  GridMap<Eigen::Index> outer_map = GridMap<Eigen::Index>::Zero( 20, 20 );
+  GridMap<Eigen::Index> inner_map = GridMap<Eigen::Index>::Zero( 20, 20 );
+  GridMap<Eigen::Index> overlapping_map = GridMap<Eigen::Index>::Zero( 20, 20 );
+  iteratePolygon<Scalar>( outer, 20, 20,
+                          [&]( Eigen::Index x, Eigen::Index y ) { outer_map( x, y ) = 1; } );
+  iteratePolygon<Scalar>( inner, 20, 20,
+                          [&]( Eigen::Index x, Eigen::Index y ) { inner_map( x, y ) = 1; } );
+  iteratePolygon<Scalar>( overlapping, 20, 20,
+                          [&]( Eigen::Index x, Eigen::Index y ) { overlapping_map( x, y ) = 1; } );
+  const GridMap<Eigen::Index> hole_map = outer_map - inner_map;
+  const GridMap<Eigen::Index> union_map = outer_map.max( overlapping_map );
+  const GridMap<Eigen::Index> xor_map = ( outer_map - overlapping_map ).abs();
+
+  auto check = [&]( const PolygonList<Scalar> &rings, FillRule fill_rule,
+                    const GridMap<Eigen::Index> &expected, const std::string &name ) {
+    CellCounter actual;
+    iterateMultiPolygon<Scalar>( rings, fill_rule, 20, 20, std::ref( actual ) );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual.map ) ) << name;
+    // Limited indexes
+    CellCounter limited;
+    iterateMultiPolygon<Scalar>( rings, fill_rule, 4, 13, 3, 15,
+                                 [&]( Eigen::Index x, Eigen::Index y ) {
+                                   EXPECT_TRUE( x >= 4 and x < 13 and y >= 3 and y < 15 ) << name;
+                                   limited( x, y );
+                                 } );
+    const GridMap<Eigen::Index> expected_limited = expected.block( 4, 3, 9, 12 );
+    const GridMap<Eigen::Index> actual_limited = limited.map.block( 4, 3, 9, 12 );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_limited, actual_limited ) )
+        << name << " with limited indexes";
+    EXPECT_EQ( limited.count, expected.block( 4, 3, 9, 12 ).sum() ) << name;
+  };
+  // Holes with even-odd fill are independent of the orientation
+  check( { outer, inner }, FillRule::EvenOdd, hole_map, "Even-odd hole" );
+  check( { outer, inner_reversed }, FillRule::EvenOdd, hole_map, "Even-odd reversed hole" );
+  // Nonzero fill requires the opposite orientation for holes
+  check( { outer, inner_reversed }, FillRule::NonZero, hole_map, "Nonzero hole" );
+  check( { outer, inner }, FillRule::NonZero, outer_map, "Nonzero same orientation" );
+  // Overlapping rings are merged with nonzero fill and each cell is only visited once
+  check( { outer, overlapping }, FillRule::NonZero, union_map, "Nonzero union" );
+  check( { outer, overlapping }, FillRule::EvenOdd, xor_map, "Even-odd overlap" );
+  check( { outer, overlapping, inner }, FillRule::EvenOdd,
+         GridMap<Eigen::Index>( ( outer_map + overlapping_map + inner_map )
+                                    .unaryExpr( []( Eigen::Index value ) { return value % 2; } ) ),
+         "Even-odd three rings" );
+
+  // Spans are disjoint and not empty
+  iterateMultiPolygonSpans<Scalar>(
+      { outer, inner }, FillRule::EvenOdd,
+      [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+        EXPECT_LT( x_start, x_end ) << "Row " << y;
+      } );
+
+  // Degenerate rings are ignored and early termination stops the iteration
+  int count = 0;
+  EXPECT_TRUE( iterateMultiPolygon<Scalar>( { Polygon<Scalar>( 2, 0 ) }, FillRule::NonZero,
+                                            [&]( Eigen::Index, Eigen::Index ) { ++count; } ) );
+  EXPECT_EQ( count, 0 );
+  EXPECT_FALSE( iterateMultiPolygon<Scalar>(
+      { outer, inner }, FillRule::EvenOdd,
+      [&]( Eigen::Index, Eigen::Index ) { return ++count < 5; } ) );
+  EXPECT_EQ( count, 5 );
+}
+
+TYPED_TEST( IteratorTest, sweptPolygonTest )
+{
+  using Scalar = TypeParam;
+  Polygon<Scalar> footprint( 2, 4 );
+  footprint.col( 0 ) << -2.3, -1.4;
+  footprint.col( 1 ) << 2.1, -1.4;
+  footprint.col( 2 ) << 2.1, 1.6;
+  footprint.col( 3 ) << -2.3, 1.6;
+  // Motion primitive along an arc and a primitive that turns in place
+  std::vector<Pose2DList<Scalar>> primitives( 2 );
+  for ( int i = 0; i <= 12; ++i ) {
+    const Scalar angle = Scalar( 0.1 ) * i;
+    primitives[0].emplace_back( 8 + 9 * std::sin( angle ), 16 - 9 * std::cos( angle ), angle );
+    primitives[1].emplace_back( 10.3, 9.7, 2 * angle );
+  }
+
+  for ( const auto &poses : primitives ) {
+    // The union of the cells of all placed footprints
+    GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 20, 20 );
+    for ( const auto &pose : poses ) {
+      Polygon<Scalar> transformed =
+          ( pose.rotation().toRotationMatrix() * footprint.matrix() ).array();
+      transformed.colwise() += pose.translation().array();
+      iteratePolygon<Scalar>( transformed, 20, 20,
+                              [&]( Eigen::Index x, Eigen::Index y ) { expected( x, y ) = 1; } );
+    }
+
+    CellCounter actual;
+    EXPECT_TRUE( iterateSweptPolygon<Scalar>( footprint, poses, 20, 20, std::ref( actual ) ) );
+    EXPECT_GT( actual.count, 0 );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual.map ) ) << "Each cell visited exactly once";
+
+    // Runs are ordered, not empty and neither overlap nor touch
+    Eigen::Index last_y = std::numeric_limits<Eigen::Index>::min(), last_x_end = 0;
+    iterateSweptPolygonSpans<Scalar>(
+        footprint, poses, 20, 20, [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+          EXPECT_LT( x_start, x_end );
+          EXPECT_TRUE( y > last_y || x_start > last_x_end ) << "Row " << y;
+          last_y = y;
+          last_x_end = x_end;
+        } );
+
+    CellCounter limited;
+    iterateSweptPolygon<Scalar>( footprint, poses, 3, 14, 5, 12,
+                                 [&]( Eigen::Index x, Eigen::Index y ) {
+                                   EXPECT_TRUE( x >= 3 and x < 14 and y >= 5 and y < 12 );
+                                   limited( x, y );
+                                 } );
+    const GridMap<Eigen::Index> expected_limited = expected.block( 3, 5, 11, 7 );
+    const GridMap<Eigen::Index> actual_limited = limited.map.block( 3, 5, 11, 7 );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_limited, actual_limited ) );
+    EXPECT_EQ( limited.count, expected_limited.sum() );
+
+    int count = 0;
+    EXPECT_FALSE( iterateSweptPolygon<Scalar>(
+        footprint, poses, [&]( Eigen::Index, Eigen::Index ) { return ++count < 7; } ) );
+    EXPECT_EQ( count, 7 );
+  }
+
+  // No poses, no cells
+  int count = 0;
+  EXPECT_TRUE( iterateSweptPolygon<Scalar>( footprint, Pose2DList<Scalar>(),
+                                            [&]( Eigen::Index, Eigen::Index ) { ++count; } ) );
+  EXPECT_EQ( count, 0 );
+}
+
+TYPED_TEST( IteratorTest, polygonOutlineTest )
+{
+  using Scalar = TypeParam;
+  std::vector<Polygon<Scalar>> polygons;
+  for ( PolygonTyp type : { PolygonTyp::RandomStructure, PolygonTyp::Z_Shape, PolygonTyp::Circle,
+                            PolygonTyp::U_Shape, PolygonTyp::Line } ) {
+    polygons.push_back( createPolygon<Scalar>( type ) );
+    polygons.back().colwise() += Point<Scalar>( 3.3, 4.2 );
+  }
+  // Polygon with notches such that runs of a row are covered by a single run of the neighbor rows
+  Polygon<Scalar> comb( 2, 8 );
+  comb << 2.2, 17.6, 17.6, 12.4, 12.4, 7.3, 7.3, 2.2, //
+      2.1, 2.1, 15.8, 15.8, 9.2, 9.2, 15.8, 15.8;
+  polygons.push_back( comb );
+  polygons.push_back( comb.rowwise().reverse() );
+  // Star shaped polygon with random radii
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> radius_dist( 3, 9 );
+  Polygon<Scalar> star( 2, 40 );
+  for ( int i = 0; i < 40; ++i ) {
+    const Scalar angle = Scalar( 2 * M_PI * i / 40 );
+    const Scalar radius = radius_dist( gen );
+    star.col( i ) << 10.2 + radius * std::cos( angle ), 9.7 + radius * std::sin( angle );
+  }
+  polygons.push_back( star );
+
+  for ( std::size_t index = 0; index < polygons.size(); ++index ) {
+    const Polygon<Scalar> &polygon = polygons[index];
+    // Brute force: cells of the polygon with at least one 4-neighbor outside of the polygon
+    GridMap<Eigen::Index> inside = GridMap<Eigen::Index>::Zero( 22, 22 );
+    Polygon<Scalar> shifted = polygon;
+    shifted.colwise() += Point<Scalar>( 1, 1 );
+    iteratePolygon<Scalar>( shifted, 22, 22,
+                            [&]( Eigen::Index x, Eigen::Index y ) { inside( x, y ) = 1; } );
+    GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 20, 20 );
+    for ( Eigen::Index x = 0; x < 20; ++x ) {
+      for ( Eigen::Index y = 0; y < 20; ++y ) {
+        if ( inside( x + 1, y + 1 ) == 0 )
+          continue;
+        expected( x, y ) = inside( x, y + 1 ) == 0 || inside( x + 2, y + 1 ) == 0 ||
+                           inside( x + 1, y ) == 0 || inside( x + 1, y + 2 ) == 0;
+      }
+    }
+
+    CellCounter actual;
+    EXPECT_TRUE( iteratePolygonOutline<Scalar>( polygon, 20, 20, std::ref( actual ) ) );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual.map ) ) << "Polygon " << index;
+
+    // Limits do not create new outline cells
+    CellCounter limited;
+    iteratePolygonOutline<Scalar>( polygon, 5, 13, 4, 11, [&]( Eigen::Index x, Eigen::Index y ) {
+      EXPECT_TRUE( x >= 5 and x < 13 and y >= 4 and y < 11 );
+      limited( x, y );
+    } );
+    const GridMap<Eigen::Index> expected_limited = expected.block( 5, 4, 8, 7 );
+    const GridMap<Eigen::Index> actual_limited = limited.map.block( 5, 4, 8, 7 );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_limited, actual_limited ) )
+        << "Polygon " << index << " with limited indexes";
+    EXPECT_EQ( limited.count, expected_limited.sum() );
+
+    // Unbounded and ordered runs
+    Eigen::Index last_y = std::numeric_limits<Eigen::Index>::min(), last_x_end = 0, count = 0;
+    iteratePolygonOutlineSpans<Scalar>(
+        polygon, [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+          EXPECT_LT( x_start, x_end );
+          EXPECT_TRUE( y > last_y || x_start > last_x_end ) << "Row " << y;
+          last_y = y;
+          last_x_end = x_end;
+          count += x_end - x_start;
+        } );
+    EXPECT_EQ( count, expected.sum() ) << "Polygon " << index;
+  }
+
+  int count = 0;
+  EXPECT_FALSE( iteratePolygonOutline<Scalar>(
+      comb, [&]( Eigen::Index, Eigen::Index ) { return ++count < 10; } ) );
+  EXPECT_EQ( count, 10 );
+}
+
+TYPED_TEST( IteratorTest, outOfBoundsPolygonTest )
+{
+  using Scalar = TypeParam;
+  // Polygons that are partially or entirely outside of the bounds [3, 17) x [2, 15) are clipped
+  // before the rasterization which must not change the visited cells
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> radius_dist( 2, 12 );
+  std::uniform_real_distribution<Scalar> position_dist( -12, 32 );
+  int partially_inside = 0;
+  int outside = 0;
+  for ( int n = 0; n < 200; ++n ) {
+    Eigen::Array<Scalar, 2, 8> polygon;
+    const Point<Scalar> center( position_dist( gen ), position_dist( gen ) );
+    for ( int i = 0; i < 8; ++i ) {
+      const Scalar angle = Scalar( 2 * M_PI * i / 8 );
+      // Every other vertex is close to the center to obtain concave polygons
+      const Scalar radius = i % 2 == 0 ? radius_dist( gen ) : radius_dist( gen ) / 4;
+      polygon.col( i ) = center + radius * Point<Scalar>( std::cos( angle ), std::sin( angle ) );
+    }
+    const Polygon<Scalar> dynamic_polygon = polygon;
+
+    GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 20, 20 );
+    Eigen::Index total = 0;
+    iteratePolygon<Scalar>( dynamic_polygon, [&]( Eigen::Index x, Eigen::Index y ) {
+      ++total;
+      if ( x >= 3 && x < 17 && y >= 2 && y < 15 )
+        ++expected( x, y );
+    } );
+    GridMap<Eigen::Index> actual = GridMap<Eigen::Index>::Zero( 20, 20 );
+    iteratePolygon<Scalar>( dynamic_polygon, 3, 17, 2, 15,
+                            [&]( Eigen::Index x, Eigen::Index y ) { ++actual( x, y ); } );
+    ASSERT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) ) << "Polygon " << n;
+    actual.setZero();
+    iteratePolygon( polygon, 3, 17, 2, 15,
+                    [&]( Eigen::Index x, Eigen::Index y ) { ++actual( x, y ); } );
+    ASSERT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) ) << "Fixed size polygon " << n;
+    if ( expected.sum() == 0 )
+      ++outside;
+    else if ( expected.sum() < total )
+      ++partially_inside;
+  }
+  EXPECT_GT( partially_inside, 20 );
+  EXPECT_GT( outside, 20 );
+
+  // Polygon that spans all rows but is only inside of the bounds in a few of them
+  Polygon<Scalar> sheared( 2, 4 );
+  sheared << -30.2, -20.2, 40.3, 30.3, //
+      -10.5, -10.5, 30.5, 30.5;
+  GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 20, 20 );
+  iteratePolygon<Scalar>( sheared, [&]( Eigen::Index x, Eigen::Index y ) {
+    if ( x >= 0 && x < 2 && y >= 0 && y < 20 )
+      ++expected( x, y );
+  } );
+  GridMap<Eigen::Index> actual = GridMap<Eigen::Index>::Zero( 20, 20 );
+  iteratePolygon<Scalar>( sheared, 0, 2, 0, 20,
+                          [&]( Eigen::Index x, Eigen::Index y ) { ++actual( x, y ); } );
+  EXPECT_GT( expected.sum(), 0 );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) );
+}
+
+TYPED_TEST( IteratorTest, tiledIteratorTest )
+{
+  using Scalar = TypeParam;
+  // Star shaped polygon with random radii that spans multiple tiles of size 4 and negative indexes
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> radius_dist( 3, 11 );
+  Polygon<Scalar> star( 2, 40 );
+  for ( int i = 0; i < 40; ++i ) {
+    const Scalar angle = Scalar( 2 * M_PI * i / 40 );
+    const Scalar radius = radius_dist( gen );
+    star.col( i ) << 9.2 + radius * std::cos( angle ), 10.7 + radius * std::sin( angle );
+  }
+  for ( const Point<Scalar> &offset : { Point<Scalar>( 0, 0 ), Point<Scalar>( -6.5, -5.1 ) } ) {
+    Polygon<Scalar> polygon = star;
+    polygon.colwise() += offset;
+    const auto polygon_spans = [&]( auto &&f ) {
+      return iteratePolygonSpans<Scalar>( polygon, f );
+    };
+    const auto tile = []( Eigen::Index index ) {
+      return index >= 0 ? index / 4 : ( index - 3 ) / 4;
+    };
+
+    // Same cells as the row by row iteration
+    GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 40, 40 );
+    iteratePolygon<Scalar>( polygon, [&]( Eigen::Index x, Eigen::Index y ) {
+      ++expected( x + 10, y + 10 );
+    } );
+    GridMap<Eigen::Index> actual = GridMap<Eigen::Index>::Zero( 40, 40 );
+    EXPECT_TRUE( iterateTiled<4>( polygon_spans, [&]( Eigen::Index x, Eigen::Index y ) {
+      ++actual( x + 10, y + 10 );
+    } ) );
+    EXPECT_GT( expected.sum(), 100 );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) ) << "Each cell visited exactly once";
+
+    // Runs are within a tile and the tiles are visited in order and only once
+    Eigen::Index last_band = std::numeric_limits<Eigen::Index>::min(), last_tile_x = 0;
+    Eigen::Index last_y = 0;
+    std::set<std::pair<Eigen::Index, Eigen::Index>> visited_tiles;
+    iterateTiledSpans<4>( polygon_spans, [&]( Eigen::Index y, Eigen::Index x_start,
+                                              Eigen::Index x_end ) {
+      EXPECT_LT( x_start, x_end );
+      EXPECT_EQ( tile( x_start ), tile( x_end - 1 ) ) << "Run crosses a tile border in row " << y;
+      const Eigen::Index band = tile( y ), tile_x = tile( x_start );
+      if ( band == last_band && tile_x == last_tile_x ) {
+        EXPECT_GE( y, last_y );
+      } else {
+        EXPECT_TRUE( band > last_band || ( band == last_band && tile_x > last_tile_x ) );
+        EXPECT_TRUE( visited_tiles.insert( { band, tile_x } ).second );
+      }
+      last_band = band;
+      last_tile_x = tile_x;
+      last_y = y;
+    } );
+    EXPECT_GT( visited_tiles.size(), 16U );
+  }
+
+  // Bounded span iterators, unsorted input and early termination
+  CellCounter counter;
+  iterateTiled<8>( [&]( auto &&f ) { return iteratePolygonSpans<Scalar>( star, 5, 17, 3, 15, f ); },
+                   std::ref( counter ) );
+  GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 20, 20 );
+  iteratePolygon<Scalar>( star, 5, 17, 3, 15,
+                          [&]( Eigen::Index x, Eigen::Index y ) { expected( x, y ) = 1; } );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, counter.map ) );
+  const auto reversed_spans = []( auto &&f ) {
+    for ( Eigen::Index y = 9; y >= 0; --y ) f( y, 2 * y, 3 * y + 1 );
+  };
+  Eigen::Index count = 0;
+  iterateTiled<4>( reversed_spans, [&]( Eigen::Index, Eigen::Index ) { ++count; } );
+  EXPECT_EQ( count, 55 );
+  count = 0;
+  EXPECT_FALSE( iterateTiled<4>( reversed_spans,
+                                 [&]( Eigen::Index, Eigen::Index ) { return ++count < 10; } ) );
+  EXPECT_EQ( count, 10 );
+}
+
+TYPED_TEST( IteratorTest, fixedPointSteppingTest )
+{
+  using Scalar = TypeParam;
+  using Vector2S = Vector2<Scalar>;
+  using Spans = std::vector<std::array<Eigen::Index, 3>>;
+  const auto collect = [&]( Spans &spans ) {
+    return [&spans]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+      spans.push_back( { y, x_start, x_end } );
+    };
+  };
+  for ( PolygonTyp type :
+        { PolygonTyp::RandomStructureNegativeIndices, PolygonTyp::RandomStructure,
+          PolygonTyp::Z_Shape, PolygonTyp::Circle, PolygonTyp::U_Shape, PolygonTyp::Line } ) {
+    for ( const Point<Scalar> &offset :
+          { Point<Scalar>( 0, 0 ), Point<Scalar>( -7.25, 3.5 ), Point<Scalar>( 1e5, -1e5 ) } ) {
+      Polygon<Scalar> polygon = createPolygon<Scalar>( type );
+      polygon.colwise() += offset;
+      Spans expected, actual;
+      iteratePolygonSpans<Scalar>( polygon, collect( expected ) );
+      EXPECT_TRUE( iteratePolygonSpansFixedPoint<Scalar>( polygon, collect( actual ) ) );
+      EXPECT_EQ( expected, actual ) << "Polygon " << type << " with offset " << offset.transpose();
+
+      const Eigen::Index x = std::round( offset.x() ), y = std::round( offset.y() );
+      expected.clear();
+      actual.clear();
+      iteratePolygonSpans<Scalar>( polygon, x + 1, x + 6, y + 2, y + 8, collect( expected ) );
+      iteratePolygonSpansFixedPoint<Scalar>( polygon, x + 1, x + 6, y + 2, y + 8,
+                                             collect( actual ) );
+      EXPECT_EQ( expected, actual ) << "Polygon " << type << " with limits";
+    }
+  }
+
+  // Rectangles of the rectangle test and rotated rectangles
+  std::vector<std::array<Vector2S, 3>> rectangles = {
+      { Vector2S( 1, 0 ), Vector2S( 1, 4 ), Vector2S( 4, 0 ) },
+      { Vector2S( 0, 0 ), Vector2S( 5, 5 ), Vector2S( 1, -1 ) },
+      { Vector2S( -3.2, -1.7 ), Vector2S( 2.3, -4.1 ), Vector2S( -1.1, 3.1 ) } };
+  for ( int i = 0; i < 12; ++i ) {
+    const Scalar angle = Scalar( 0.27 ) * i;
+    const Vector2S a( 4.3 + 0.1 * i, 5.1 - 0.3 * i );
+    const Vector2S u( std::cos( angle ), std::sin( angle ) ), v( -u.y(), u.x() );
+    rectangles.push_back(
+        { a, Vector2S( a + Scalar( 6.3 ) * u ), Vector2S( a + Scalar( 2.7 ) * v ) } );
+  }
+  for ( std::size_t i = 0; i < rectangles.size(); ++i ) {
+    const auto &[a, b, c] = rectangles[i];
+    Spans expected, actual;
+    iterateRectangleSpans<Scalar>( a, b, c, collect( expected ) );
+    EXPECT_TRUE( iterateRectangleSpansFixedPoint<Scalar>( a, b, c, collect( actual ) ) );
+    EXPECT_FALSE( expected.empty() );
+    EXPECT_EQ( expected, actual ) << "Rectangle " << i;
+    expected.clear();
+    actual.clear();
+    iterateRectangleSpans<Scalar>( a, b, c, 1, 5, 0, 4, collect( expected ) );
+    iterateRectangleSpansFixedPoint<Scalar>( a, b, c, 1, 5, 0, 4, collect( actual ) );
+    EXPECT_EQ( expected, actual ) << "Rectangle " << i << " with limits";
+  }
+
+  // Per cell variants and early termination
+  const Polygon<Scalar> polygon = createPolygon<Scalar>( PolygonTyp::Circle );
+  GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 20, 20 );
+  iteratePolygon<Scalar>( polygon, 20, 20,
+                          [&]( Eigen::Index x, Eigen::Index y ) { ++expected( x, y ); } );
+  CellCounter actual;
+  EXPECT_TRUE( iteratePolygonFixedPoint<Scalar>( polygon, 20, 20, std::ref( actual ) ) );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual.map ) );
+  int count = 0;
+  EXPECT_FALSE( iteratePolygonFixedPoint<Scalar>(
+      polygon, [&]( Eigen::Index, Eigen::Index ) { return ++count < 10; } ) );
+  EXPECT_EQ( count, 10 );
+  count = 0;
+  EXPECT_FALSE( iterateRectangleFixedPoint<Scalar>(
+      rectangles[0][0], rectangles[0][1], rectangles[0][2],
+      [&]( Eigen::Index, Eigen::Index ) { return ++count < 5; } ) );
+  EXPECT_EQ( count, 5 );
+
+  // Rounding of the fixed-point values is half away from zero like std::round
+  for ( double value : { -2.5, -2.4999, -2.0, -1.5, -0.5, -0.25, 0.0, 0.25, 0.5, 1.5, 2.4999, 2.5,
+                         1e6 + 0.5, -1e6 - 0.5 } ) {
+    using detail::FixedPointStepping;
+    EXPECT_EQ( FixedPointStepping::toIndex( FixedPointStepping::fromDouble( value ) ),
+               std::round( value ) )
+        << value;
+  }
+}
+
+TYPED_TEST( IteratorTest, cellRangeTest )
+{
+  using Scalar = TypeParam;
+  using Cell = Vector2<Eigen::Index>;
+  const Polygon<Scalar> polygon = createPolygon<Scalar>( PolygonTyp::RandomStructure );
+  const Vector2<Scalar> center( 5.3, 6.1 );
+  const Vector2<Scalar> a( 1.2, 3.4 ), b( 7.6, 8.1 ), c( 3.7, -0.2 );
+
+  // Same cells in the same order as the callback iterators
+  const auto check_order = [&]( const CellRange &range, const auto &iterate, const char *name ) {
+    std::vector<Cell> expected;
+    iterate( [&]( Eigen::Index x, Eigen::Index y ) { expected.emplace_back( x, y ); } );
+    std::vector<Cell> actual;
+    for ( const Cell &cell : range ) actual.push_back( cell );
+    EXPECT_GT( expected.size(), 10U ) << name;
+    ASSERT_EQ( actual.size(), expected.size() ) << name;
+    EXPECT_EQ( range.size(), expected.size() ) << name;
+    EXPECT_EQ( std::distance( range.begin(), range.end() ), Eigen::Index( expected.size() ) )
+        << name;
+    for ( size_t i = 0; i < expected.size(); ++i ) {
+      EXPECT_EQ( actual[i], expected[i] ) << name << " at " << i;
+      EXPECT_EQ( range.begin()[i], expected[i] ) << name << " at " << i;
+      EXPECT_EQ( ( range.begin() + i ) - range.begin(), Eigen::Index( i ) ) << name;
+    }
+    // Backwards from the end
+    size_t i = expected.size();
+    for ( auto it = range.end(); it != range.begin(); ) {
+      --it;
+      --i;
+      EXPECT_EQ( *it, expected[i] ) << name << " at " << i;
+      EXPECT_EQ( it->x(), it.x() ) << name << " at " << i;
+    }
+    // The iterators satisfy the forward iterator requirements of the random access tag, i.e.,
+    // equal iterators dereference to the same object, which is required by std::reverse_iterator
+    static_assert( std::is_same<std::iterator_traits<CellRange::iterator>::reference,
+                                const CellRange::value_type &>::value );
+    EXPECT_EQ( &*range.begin(), &*( range.end() - expected.size() ) ) << name;
+    std::vector<Cell> reversed;
+    for ( auto it = std::make_reverse_iterator( range.end() );
+          it != std::make_reverse_iterator( range.begin() ); ++it )
+      reversed.push_back( *it );
+    EXPECT_TRUE( std::equal( reversed.rbegin(), reversed.rend(), expected.begin(), expected.end() ) )
+        << name;
+    EXPECT_EQ( *std::prev( range.end() ), expected.back() ) << name;
+    EXPECT_EQ( std::prev( range.end() )->x(), expected.back().x() ) << name;
+    EXPECT_TRUE( range.begin() + expected.size() == range.end() ) << name;
+    EXPECT_TRUE( range.end() - expected.size() == range.begin() ) << name;
+  };
+  check_order( polygonRange<Scalar>( polygon ),
+               [&]( auto &&f ) { iteratePolygon<Scalar>( polygon, f ); }, "polygon" );
+  check_order( polygonRange<Scalar>( polygon, 2, 8, 1, 7 ),
+               [&]( auto &&f ) { iteratePolygon<Scalar>( polygon, 2, 8, 1, 7, f ); },
+               "bounded polygon" );
+  check_order( circleRange<Scalar>( center, 3.7, 10, 10 ),
+               [&]( auto &&f ) { iterateCircle<Scalar>( center, 3.7, 10, 10, f ); }, "circle" );
+  check_order( rectangleRange<Scalar>( a, b, c ),
+               [&]( auto &&f ) { iterateRectangle<Scalar>( a, b, c, f ); }, "rectangle" );
+
+  // STL algorithms
+  const CellRange range = circleRange<Scalar>( center, 4.2 );
+  Eigen::Index expected_sum = 0;
+  iterateCircle<Scalar>( center, 4.2,
+                         [&]( Eigen::Index x, Eigen::Index y ) { expected_sum += x * 100 + y; } );
+  EXPECT_EQ( std::transform_reduce( range.begin(), range.end(), Eigen::Index( 0 ), std::plus<>(),
+                                    []( const Cell &cell ) { return cell.x() * 100 + cell.y(); } ),
+             expected_sum );
+  const auto it = std::find_if( range.begin(), range.end(),
+                                []( const Cell &cell ) { return cell.x() == 5 && cell.y() == 6; } );
+  ASSERT_NE( it, range.end() );
+  EXPECT_EQ( it.x(), 5 );
+  EXPECT_EQ( it.y(), 6 );
+
+  // Interleaved traversal of two ranges can be suspended and resumed
+  const CellRange first = polygonRange<Scalar>( polygon );
+  const CellRange second = rectangleRange<Scalar>( a, b, c );
+  std::vector<Cell> first_cells, second_cells;
+  auto first_it = first.begin(), second_it = second.begin();
+  while ( first_it != first.end() || second_it != second.end() ) {
+    if ( first_it != first.end() )
+      first_cells.push_back( *first_it++ );
+    if ( second_it != second.end() )
+      second_cells.push_back( *second_it++ );
+  }
+  EXPECT_TRUE( std::equal( first_cells.begin(), first_cells.end(), first.begin(), first.end() ) );
+  EXPECT_TRUE(
+      std::equal( second_cells.begin(), second_cells.end(), second.begin(), second.end() ) );
+
+  // Empty ranges
+  const CellRange empty = polygonRange<Scalar>( polygon, 100, 110, 100, 110 );
+  EXPECT_TRUE( empty.empty() );
+  EXPECT_EQ( empty.size(), 0U );
+  EXPECT_TRUE( empty.begin() == empty.end() );
+  EXPECT_TRUE( CellRange().begin() == CellRange().end() );
+}
+
+TYPED_TEST( IteratorTest, circleStencilTest )
+{
+  using Scalar = TypeParam;
+  using Span = std::tuple<Eigen::Index, Eigen::Index, Eigen::Index>;
+  const auto collect = [&]( const auto &iterate ) {
+    std::vector<Span> spans;
+    iterate( [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+      spans.emplace_back( y, x_start, x_end );
+    } );
+    return spans;
+  };
+  CircleStencilCache cache;
+  // Integer radii produce rows where the circle passes exactly through a cell center
+  for ( double radius : { 0.3, 1.0, 2.5, 3.7, 5.0, 12.0 } ) {
+    const CircleStencil &stencil = cache.stencil( radius );
+    EXPECT_EQ( &stencil, &cache.stencil( radius ) ) << "Stencil should only be created once";
+    // Exactly the same runs for centers at cell centers, corners and quarter offsets in the map
+    for ( Scalar cx = 0; cx < 30; cx += Scalar( 0.25 ) ) {
+      for ( Scalar cy : { 0.0, 0.25, 7.5, 13.75, 29.0 } ) {
+        const Vector2<Scalar> center( cx, cy );
+        const auto expected = collect(
+            [&]( auto &&f ) { return iterateCircleSpans<Scalar>( center, radius, 30, 30, f ); } );
+        const auto actual = collect(
+            [&]( auto &&f ) { return iterateCircleSpans<Scalar>( stencil, center, 30, 30, f ); } );
+        ASSERT_EQ( actual, expected ) << "radius: " << radius << ", center: " << cx << ", " << cy;
+      }
+    }
+    // Other centers are discretized to the nearest quarter
+    const Vector2<Scalar> center( 8.37, -3.9 ), discretized( 8.25, -4 );
+    EXPECT_EQ(
+        collect( [&]( auto &&f ) { return iterateCircleSpans<Scalar>( stencil, center, f ); } ),
+        collect(
+            [&]( auto &&f ) { return iterateCircleSpans<Scalar>( stencil, discretized, f ); } ) );
+  }
+  EXPECT_EQ( cache.size(), 6U );
+
+  // Per cell overload with bounds and early stop
+  const CircleStencil stencil( 4.2, 2 );
+  const Vector2<Scalar> center( 3.5, 2.5 );
+  GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 8, 6 );
+  iterateCircle<Scalar>( center, 4.2, 1, 8, 0, 6,
+                         [&]( Eigen::Index x, Eigen::Index y ) { ++expected( x, y ); } );
+  GridMap<Eigen::Index> actual = GridMap<Eigen::Index>::Zero( 8, 6 );
+  EXPECT_TRUE( iterateCircle<Scalar>(
+      stencil, center, 1, 8, 0, 6, [&]( Eigen::Index x, Eigen::Index y ) { ++actual( x, y ); } ) );
+  EXPECT_GT( expected.sum(), 20 );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) );
+  int count = 0;
+  EXPECT_FALSE( iterateCircle<Scalar>( stencil, center, [&]( Eigen::Index, Eigen::Index ) {
+    return ++count < 7;
+  } ) );
+  EXPECT_EQ( count, 7 );
+  EXPECT_THROW( CircleStencil( 2, 0 ), std::invalid_argument );
+}
+
+TYPED_TEST( IteratorTest, closedFormShapesTest )
+{
+  using Scalar = TypeParam;
+  // Compares the cells of an iterator with all cells in a 40x40 map whose center is inside
+  const auto check = [&]( const auto &iterate, const auto &inside, const std::string &name ) {
+    GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 40, 40 );
+    for ( Eigen::Index x = 0; x < 40; ++x ) {
+      for ( Eigen::Index y = 0; y < 40; ++y ) expected( x, y ) = inside( x + 0.5, y + 0.5 ) ? 1 : 0;
+    }
+    GridMap<Eigen::Index> actual = GridMap<Eigen::Index>::Zero( 40, 40 );
+    Eigen::Index last_y = -1, last_x_end = -1;
+    EXPECT_TRUE( iterate( [&]( Eigen::Index y, Eigen::Index x_start, Eigen::Index x_end ) {
+      EXPECT_LT( x_start, x_end ) << name;
+      EXPECT_TRUE( y > last_y || ( y == last_y && x_start >= last_x_end ) ) << name;
+      last_y = y;
+      last_x_end = x_end;
+      actual.col( y ).segment( x_start, x_end - x_start ) += 1;
+    } ) ) << name;
+    EXPECT_GT( expected.sum(), 5 ) << name;
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) ) << name;
+  };
+  const Vector2<Scalar> center( 19.3, 20.6 );
+
+  // Ellipse
+  for ( double angle : { 0.0, 0.4, 1.2, M_PI / 2, 2.9, -0.7 } ) {
+    const double radius_x = 13.3, radius_y = 5.1;
+    check(
+        [&]( auto &&f ) {
+          return iterateEllipseSpans<Scalar>( center, radius_x, radius_y, angle, 40, 40, f );
+        },
+        [&]( double x, double y ) {
+          const double dx = x - center.x(), dy = y - center.y();
+          const double u = dx * std::cos( angle ) + dy * std::sin( angle );
+          const double v = -dx * std::sin( angle ) + dy * std::cos( angle );
+          return u * u / ( radius_x * radius_x ) + v * v / ( radius_y * radius_y ) <= 1;
+        },
+        "ellipse " + std::to_string( angle ) );
+  }
+  // A circular ellipse is the circle
+  GridMap<Eigen::Index> expected = GridMap<Eigen::Index>::Zero( 40, 40 );
+  iterateCircle<Scalar>( center, 7.3, 40, 40,
+                         [&]( Eigen::Index x, Eigen::Index y ) { ++expected( x, y ); } );
+  GridMap<Eigen::Index> actual = GridMap<Eigen::Index>::Zero( 40, 40 );
+  iterateEllipse<Scalar>( center, 7.3, 7.3, 0.3, 40, 40,
+                          [&]( Eigen::Index x, Eigen::Index y ) { ++actual( x, y ); } );
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) );
+
+  // Annulus
+  for ( double inner_radius : { 0.0, 0.4, 3.2, 8.0, 11.9 } ) {
+    check(
+        [&]( auto &&f ) {
+          return iterateAnnulusSpans<Scalar>( center, inner_radius, 12.1, 40, 40, f );
+        },
+        [&]( double x, double y ) {
+          const double distance =
+              ( Vector2<double>( x, y ) - center.template cast<double>() ).norm();
+          return distance >= inner_radius && distance <= 12.1;
+        },
+        "annulus " + std::to_string( inner_radius ) );
+  }
+  // The annulus consists of the cells of the outer circle that are not in the inner circle, also
+  // for integer radii and centers where the circles pass through cell centers
+  for ( double inner_radius : { 2.0, 3.0, 5.5 } ) {
+    const Vector2<Scalar> cell_center( 10.5, 12.5 );
+    expected.setZero();
+    iterateCircle<Scalar>( cell_center, 8.0, 40, 40,
+                           [&]( Eigen::Index x, Eigen::Index y ) { ++expected( x, y ); } );
+    iterateCircle<Scalar>( cell_center, inner_radius, 40, 40,
+                           [&]( Eigen::Index x, Eigen::Index y ) { --expected( x, y ); } );
+    actual.setZero();
+    iterateAnnulus<Scalar>( cell_center, inner_radius, 8.0, 40, 40,
+                            [&]( Eigen::Index x, Eigen::Index y ) { ++actual( x, y ); } );
+    EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected, actual ) ) << inner_radius;
+  }
+
+  // Sector
+  for ( double direction : { 0.0, 0.9, M_PI / 2, 2.2, -2.5 } ) {
+    for ( double opening_angle : { 0.6, M_PI / 2, 2.7, M_PI, 3.9, 5.8, 2 * M_PI } ) {
+      check(
+          [&]( auto &&f ) {
+            return iterateSectorSpans<Scalar>( center, 14.2, direction, opening_angle, 40, 40, f );
+          },
+          [&]( double x, double y ) {
+            const double dx = x - center.x(), dy = y - center.y();
+            if ( dx * dx + dy * dy > 14.2 * 14.2 )
+              return false;
+            const double delta = std::remainder( std::atan2( dy, dx ) - direction, 2 * M_PI );
+            return std::abs( delta ) <= opening_angle / 2;
+          },
+          "sector " + std::to_string( direction ) + ", " + std::to_string( opening_angle ) );
+    }
+  }
+
+  // Bounds and early stop
+  int count = 0;
+  EXPECT_FALSE( iterateSector<Scalar>( center, 10, 0.3, 2, 15, 25, 15, 25,
+                                       [&]( Eigen::Index x, Eigen::Index y ) {
+                                         EXPECT_TRUE( x >= 15 && x < 25 && y >= 15 && y < 25 );
+                                         return ++count < 12;
+                                       } ) );
+  EXPECT_EQ( count, 12 );
+  count = 0;
+  EXPECT_TRUE( iterateAnnulus<Scalar>( center, 3, 6, 18, 22, 17, 30,
+                                       [&]( Eigen::Index x, Eigen::Index y ) {
+                                         EXPECT_TRUE( x >= 18 && x < 22 && y >= 17 && y < 30 );
+                                         ++count;
+                                       } ) );
+  EXPECT_GT( count, 0 );
+  count = 0;
+  EXPECT_FALSE( iterateEllipse<Scalar>( center, 8, 3, 0.5, [&]( Eigen::Index, Eigen::Index ) {
+    return ++count < 9;
+  } ) );
+  EXPECT_EQ( count, 9 );
+}
+
 int main( int argc, char **argv )
 {
   testing::InitGoogleTest( &argc, argv );
@@ -1,9 +1,16 @@
 // Copyright (c) 2022, 2024 Aljoscha Schmidt, Stefan Fabian. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 #include <hector_math/map_operations/find_minmax.h>
+#include <hector_math/map_operations/find_minmax_parallel.h>
+#include <hector_math/map_operations/find_minmax_tiled.h>
+#include <hector_math/map_operations/find_statistics.h>
+#include <hector_math/map_operations/integral_image.h>
+#include <hector_math/map_operations/range_extremum_table.h>
 #include <hector_math/map_operations/fit_plane.h>
+#include <hector_math/map_operations/raycast.h>
 
 #include <gtest/gtest.h>
+#include <random>
 
 using namespace hector_math;
 
@@ -91,6 +98,433 @@ TYPED_TEST( MapOperations, find_minmax )
   EXPECT_EQ( findMaximum<Scalar>( map, polygon ), std::numeric_limits<Scalar>::infinity() );
 }
 
+TYPED_TEST( MapOperations, find_minmax_tiled )
+{
+  using Scalar = TypeParam;
+  const Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> value_dist( -10, 10 );
+  GridMap<Scalar> map( 150, 130 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x )
+      map( x, y ) = ( x + y ) % 7 == 0 ? NaN : value_dist( gen );
+  }
+  const TiledGridMap<Scalar, 16> tiled( map );
+  const TiledGridMap<Scalar> tiled_default( map );
+  Polygon<Scalar> polygon( 2, 5 );
+  polygon << 3.4, 140.2, 152.7, 71.3, -4.1, //
+      12.6, -3.2, 88.9, 131.5, 77.7;
+  for ( int i = 0; i < 3; ++i ) {
+    EXPECT_EQ( findMinimum<Scalar>( tiled, polygon ), findMinimum<Scalar>( map, polygon ) );
+    EXPECT_EQ( findMaximum<Scalar>( tiled, polygon ), findMaximum<Scalar>( map, polygon ) );
+    EXPECT_EQ( findMinimum( tiled_default, polygon ), findMinimum<Scalar>( map, polygon ) );
+    EXPECT_EQ( findMaximum( tiled_default, polygon ), findMaximum<Scalar>( map, polygon ) );
+    polygon *= Scalar( 0.4 );
+    polygon.colwise() += Point<Scalar>( 17.3, 9.1 );
+  }
+
+  // Polygon outside of the map
+  polygon.colwise() += Point<Scalar>( 500, 0 );
+  EXPECT_TRUE( std::isnan( findMinimum<Scalar>( tiled, polygon ) ) );
+  EXPECT_TRUE( std::isnan( findMaximum<Scalar>( tiled, polygon ) ) );
+}
+
+TYPED_TEST( MapOperations, find_minmax_index )
+{
+  using Scalar = TypeParam;
+  const Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
+  const Scalar inf = std::numeric_limits<Scalar>::infinity();
+  // Reference implementation: first extremum in column-major order ignoring NaN values
+  const auto reference = [&]( const auto &map, bool maximum, Eigen::Index &row,
+                              Eigen::Index &col ) {
+    Scalar best = NaN;
+    for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+      for ( Eigen::Index x = 0; x < map.rows(); ++x ) {
+        const Scalar val = map( x, y );
+        if ( std::isnan( val ) ||
+             ( !std::isnan( best ) && ( maximum ? val <= best : val >= best ) ) )
+          continue;
+        best = val;
+        row = x;
+        col = y;
+      }
+    }
+    return best;
+  };
+  const auto check = [&]( const auto &map, const std::string &name ) {
+    for ( bool maximum : { false, true } ) {
+      Eigen::Index expected_row = -1, expected_col = -1, row = -1, col = -1;
+      const Scalar expected = reference( map, maximum, expected_row, expected_col );
+      const Scalar actual = maximum ? findMaximumAndIndex( map, row, col )
+                                    : findMinimumAndIndex( map, row, col );
+      if ( std::isnan( expected ) ) {
+        EXPECT_TRUE( std::isnan( actual ) ) << name;
+      } else {
+        EXPECT_EQ( actual, expected ) << name << ( maximum ? " max" : " min" );
+      }
+      EXPECT_EQ( row, expected_row ) << name << ( maximum ? " max" : " min" );
+      EXPECT_EQ( col, expected_col ) << name << ( maximum ? " max" : " min" );
+    }
+  };
+
+  std::mt19937 gen( 42 );
+  std::uniform_int_distribution<int> value_dist( -20, 20 );
+  std::uniform_real_distribution<Scalar> nan_dist( 0, 1 );
+  const std::pair<Eigen::Index, Eigen::Index> sizes[] = { { 1, 1 },   { 7, 3 },   { 1, 37 },
+                                                          { 33, 17 }, { 64, 64 }, { 129, 71 } };
+  for ( const auto &size : sizes ) {
+    for ( Scalar nan_ratio : { Scalar( 0 ), Scalar( 0.3 ), Scalar( 0.97 ) } ) {
+      // Few distinct values, hence, ties are common and the first occurrence has to be found
+      GridMap<Scalar> map( size.first, size.second );
+      for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+        for ( Eigen::Index x = 0; x < map.rows(); ++x )
+          map( x, y ) = nan_dist( gen ) < nan_ratio ? NaN : Scalar( value_dist( gen ) );
+      }
+      const std::string name = std::to_string( size.first ) + "x" + std::to_string( size.second ) +
+                               " nan: " + std::to_string( nan_ratio );
+      check( map, name );
+      if ( map.rows() > 2 && map.cols() > 2 )
+        check( map.block( 1, 1, map.rows() - 2, map.cols() - 2 ), name + " block" );
+      check( map * Scalar( 2 ), name + " expression" );
+      if ( map.size() > 4 ) {
+        map( map.rows() - 1, map.cols() - 1 ) = -inf;
+        map( 0, map.cols() / 2 ) = inf;
+        check( map, name + " inf" );
+      }
+    }
+  }
+
+  // No values that are not NaN, the indexes are not modified
+  GridMap<Scalar> map = GridMap<Scalar>::Constant( 19, 5, NaN );
+  check( map, "all NaN" );
+  map.resize( 0, 0 );
+  check( map, "empty" );
+
+  // Integer maps use the scalar implementation
+  GridMap<int> int_map( 5, 4 );
+  int_map << 3, 1, 4, 1, //
+      5, 9, 2, 6,        //
+      5, 3, 5, 8,        //
+      9, 7, 9, 3,        //
+      2, 3, 8, 4;
+  Eigen::Index row, col;
+  EXPECT_EQ( findMinimumAndIndex( int_map, row, col ), 1 );
+  EXPECT_EQ( row, 0 );
+  EXPECT_EQ( col, 1 );
+  EXPECT_EQ( findMaximumAndIndex( int_map, row, col ), 9 );
+  EXPECT_EQ( row, 3 );
+  EXPECT_EQ( col, 0 );
+}
+
+TYPED_TEST( MapOperations, find_minmax_index_parallel )
+{
+  using Scalar = TypeParam;
+  const Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
+  // A single thread pool searches two blocks, one on the worker and one on the calling thread
+  ThreadPool single_pool( 1 ), pool( 4 );
+  // The parallel versions have to return exactly the same value and index as the serial versions
+  const auto check = [&]( const auto &map, const std::string &name ) {
+    for ( ThreadPool *p : { &single_pool, &pool } ) {
+      Eigen::Index expected_row = -1, expected_col = -1, row = -1, col = -1;
+      Scalar expected = findMinimumAndIndex( map, expected_row, expected_col );
+      Scalar actual = findMinimumAndIndexParallel( *p, map, row, col );
+      EXPECT_TRUE( actual == expected || ( std::isnan( actual ) && std::isnan( expected ) ) )
+          << name;
+      EXPECT_EQ( row, expected_row ) << name << " min with " << p->size() << " threads";
+      EXPECT_EQ( col, expected_col ) << name << " min with " << p->size() << " threads";
+      expected_row = expected_col = row = col = -1;
+      expected = findMaximumAndIndex( map, expected_row, expected_col );
+      actual = findMaximumAndIndexParallel( *p, map, row, col );
+      EXPECT_TRUE( actual == expected || ( std::isnan( actual ) && std::isnan( expected ) ) )
+          << name;
+      EXPECT_EQ( row, expected_row ) << name << " max with " << p->size() << " threads";
+      EXPECT_EQ( col, expected_col ) << name << " max with " << p->size() << " threads";
+    }
+  };
+
+  std::mt19937 gen( 42 );
+  std::uniform_int_distribution<int> value_dist( -20, 20 );
+  std::uniform_real_distribution<Scalar> nan_dist( 0, 1 );
+  // Few distinct values, hence, the extremum occurs in multiple blocks and ties have to be resolved
+  // to the first block
+  GridMap<Scalar> map( 601, 599 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x )
+      map( x, y ) = nan_dist( gen ) < 0.1 ? NaN : Scalar( value_dist( gen ) );
+  }
+  check( map, "map" );
+  check( map.block( 3, 5, 590, 580 ), "block" );
+  check( map * Scalar( 2 ), "expression" );
+  check( map.block( 0, 0, 20, 20 ), "small" );
+  // The extremum is only in the last block
+  map.leftCols( 500 ).setConstant( NaN );
+  map( 17, 590 ) = -100;
+  map( 19, 595 ) = 100;
+  check( map, "last block" );
+  map.setConstant( NaN );
+  check( map, "all NaN" );
+}
+
+TYPED_TEST( MapOperations, find_statistics )
+{
+  using Scalar = TypeParam;
+  const Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
+  std::mt19937 gen( 42 );
+  std::uniform_int_distribution<int> value_dist( -20, 20 );
+  std::uniform_real_distribution<Scalar> nan_dist( 0, 1 );
+  GridMap<Scalar> map( 60, 50 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x )
+      map( x, y ) = nan_dist( gen ) < 0.2 ? NaN : Scalar( 1000 + value_dist( gen ) ) / 8;
+  }
+
+  // Reference: collect the cells of the region and compute everything in separate passes
+  const auto check = [&]( const auto &iterate, const RegionStatistics<Scalar> &stats,
+                          const std::string &name ) {
+    std::vector<Scalar> values;
+    Eigen::Index nan_count = 0;
+    RegionStatistics<Scalar> expected;
+    iterate( [&]( Eigen::Index x, Eigen::Index y ) {
+      const Scalar val = map( x, y );
+      if ( std::isnan( val ) ) {
+        ++nan_count;
+        return;
+      }
+      if ( values.empty() || val < expected.minimum ) {
+        expected.minimum = val;
+        expected.minimum_x = x;
+        expected.minimum_y = y;
+      }
+      if ( values.empty() || val > expected.maximum ) {
+        expected.maximum = val;
+        expected.maximum_x = x;
+        expected.maximum_y = y;
+      }
+      values.push_back( val );
+    } );
+    EXPECT_EQ( stats.nan_count, nan_count ) << name;
+    ASSERT_EQ( stats.valid_count, static_cast<Eigen::Index>( values.size() ) ) << name;
+    if ( values.empty() ) {
+      EXPECT_TRUE( std::isnan( stats.minimum ) ) << name;
+      EXPECT_TRUE( std::isnan( stats.maximum ) ) << name;
+      EXPECT_TRUE( std::isnan( stats.mean ) ) << name;
+      EXPECT_TRUE( std::isnan( stats.variance ) ) << name;
+      return;
+    }
+    double mean = 0;
+    for ( Scalar val : values ) mean += val;
+    mean /= values.size();
+    double variance = 0;
+    for ( Scalar val : values ) variance += ( val - mean ) * ( val - mean );
+    variance /= values.size();
+    EXPECT_EQ( stats.minimum, expected.minimum ) << name;
+    EXPECT_EQ( stats.minimum_x, expected.minimum_x ) << name;
+    EXPECT_EQ( stats.minimum_y, expected.minimum_y ) << name;
+    EXPECT_EQ( stats.maximum, expected.maximum ) << name;
+    EXPECT_EQ( stats.maximum_x, expected.maximum_x ) << name;
+    EXPECT_EQ( stats.maximum_y, expected.maximum_y ) << name;
+    EXPECT_NEAR( stats.mean, mean, 1E-4 ) << name;
+    EXPECT_NEAR( stats.variance, variance, 1E-3 ) << name;
+  };
+
+  Polygon<Scalar> polygon( 2, 5 );
+  polygon.col( 0 ) << -3, 4;
+  polygon.col( 1 ) << 30, -2;
+  polygon.col( 2 ) << 55, 20;
+  polygon.col( 3 ) << 35, 47;
+  polygon.col( 4 ) << 10, 30;
+  check( [&]( auto f ) { iteratePolygon( polygon, map.rows(), map.cols(), f ); },
+         findStatistics<Scalar>( map, polygon ), "polygon" );
+  EXPECT_EQ( findStatistics<Scalar>( map, polygon ).minimum, findMinimum<Scalar>( map, polygon ) );
+  EXPECT_EQ( findStatistics<Scalar>( map, polygon ).maximum, findMaximum<Scalar>( map, polygon ) );
+
+  const Vector2<Scalar> center( 20.3, 31.7 );
+  for ( Scalar radius : { Scalar( 0.4 ), Scalar( 3.5 ), Scalar( 12.2 ), Scalar( 40 ) } ) {
+    check( [&]( auto f ) { iterateCircle( center, radius, map.rows(), map.cols(), f ); },
+           findStatistics<Scalar>( map, center, radius ), "circle " + std::to_string( radius ) );
+  }
+
+  const Vector2<Scalar> a( 5.2, 8.1 ), b( 30.4, 20.7 ), c( -1.1, 20.7 );
+  check( [&]( auto f ) { iterateRectangle( a, b, c, map.rows(), map.cols(), f ); },
+         findStatistics<Scalar>( map, a, b, c ), "rectangle" );
+
+  // Regions without valid values
+  const Vector2<Scalar> outside( -20, -20 );
+  check( [&]( auto f ) { iterateCircle( outside, Scalar( 5 ), map.rows(), map.cols(), f ); },
+         findStatistics<Scalar>( map, outside, Scalar( 5 ) ), "outside" );
+  map.block( 0, 0, 20, 20 ).setConstant( NaN );
+  const Vector2<Scalar> nan_center( 10, 10 );
+  check( [&]( auto f ) { iterateCircle( nan_center, Scalar( 5 ), map.rows(), map.cols(), f ); },
+         findStatistics<Scalar>( map, nan_center, Scalar( 5 ) ), "all NaN" );
+
+  // Large offset with a small spread, a naive sum of squares loses the variance for floats
+  GridMap<Scalar> offset_map( 100, 100 );
+  for ( Eigen::Index y = 0; y < offset_map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < offset_map.rows(); ++x )
+      offset_map( x, y ) = Scalar( 10000 ) + Scalar( ( x + y ) % 2 );
+  }
+  const RegionStatistics<Scalar> offset_stats =
+      findStatistics<Scalar>( offset_map, Vector2<Scalar>( 0, 0 ), Vector2<Scalar>( 100, 0 ),
+                              Vector2<Scalar>( 0, 100 ) );
+  EXPECT_EQ( offset_stats.valid_count, 10000 );
+  EXPECT_NEAR( offset_stats.mean, 10000.5, 1E-3 );
+  EXPECT_NEAR( offset_stats.variance, 0.25, 1E-3 );
+}
+
+TYPED_TEST( MapOperations, integral_image )
+{
+  using Scalar = TypeParam;
+  const Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> value_dist( -1, 1 );
+  std::uniform_real_distribution<Scalar> nan_dist( 0, 1 );
+  // Elevations with a large offset and a small spread
+  GridMap<Scalar> map( 37, 29 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x )
+      map( x, y ) = nan_dist( gen ) < 0.15 ? NaN : Scalar( 1000 ) + value_dist( gen );
+  }
+  map( 3, 4 ) = std::numeric_limits<Scalar>::infinity();
+
+  const auto check = [&]( const IntegralImage<Scalar> &image, const std::string &name ) {
+    ASSERT_EQ( image.rows(), map.rows() );
+    ASSERT_EQ( image.cols(), map.cols() );
+    for ( Eigen::Index x = -2; x < map.rows(); x += 3 ) {
+      for ( Eigen::Index y = -1; y < map.cols(); y += 4 ) {
+        for ( Eigen::Index size : { 1, 2, 5, 13, 40 } ) {
+          // Reference computed from the clamped block
+          const Eigen::Index x_start = std::max<Eigen::Index>( 0, x );
+          const Eigen::Index y_start = std::max<Eigen::Index>( 0, y );
+          const Eigen::Index x_end = std::min( map.rows(), x + size );
+          const Eigen::Index y_end = std::min( map.cols(), y + 2 * size );
+          std::vector<double> values;
+          for ( Eigen::Index j = y_start; j < y_end; ++j ) {
+            for ( Eigen::Index i = x_start; i < x_end; ++i ) {
+              if ( std::isfinite( map( i, j ) ) )
+                values.push_back( map( i, j ) );
+            }
+          }
+          const std::string block = name + " block " + std::to_string( x ) + ", " +
+                                    std::to_string( y ) + ", " + std::to_string( size );
+          ASSERT_EQ( image.count( x, y, size, 2 * size ),
+                     static_cast<Eigen::Index>( values.size() ) )
+              << block;
+          if ( values.empty() ) {
+            EXPECT_EQ( image.sum( x, y, size, 2 * size ), 0 ) << block;
+            EXPECT_TRUE( std::isnan( image.mean( x, y, size, 2 * size ) ) ) << block;
+            EXPECT_TRUE( std::isnan( image.variance( x, y, size, 2 * size ) ) ) << block;
+            continue;
+          }
+          double sum = 0;
+          for ( double val : values ) sum += val;
+          const double mean = sum / values.size();
+          double variance = 0;
+          for ( double val : values ) variance += ( val - mean ) * ( val - mean );
+          variance /= values.size();
+          EXPECT_NEAR( image.sum( x, y, size, 2 * size ), sum, std::abs( sum ) * 1E-6 ) << block;
+          EXPECT_NEAR( image.mean( x, y, size, 2 * size ), mean, 1E-3 ) << block;
+          EXPECT_NEAR( image.variance( x, y, size, 2 * size ), variance, 1E-4 ) << block;
+        }
+      }
+    }
+  };
+  IntegralImage<Scalar> image( map );
+  check( image, "initial" );
+
+  // Update a dirty block and compare against the reference and a full rebuild
+  for ( Eigen::Index y = 10; y < 15; ++y ) {
+    for ( Eigen::Index x = 20; x < 26; ++x ) map( x, y ) = Scalar( 990 ) + value_dist( gen );
+  }
+  map( 22, 12 ) = NaN;
+  image.update( map, 20, 10, 6, 5 );
+  check( image, "updated" );
+  const IntegralImage<Scalar> rebuilt( map );
+  EXPECT_EQ( image.count( 0, 0, map.rows(), map.cols() ),
+             rebuilt.count( 0, 0, map.rows(), map.cols() ) );
+  EXPECT_NEAR( image.mean( 5, 5, 30, 20 ), rebuilt.mean( 5, 5, 30, 20 ), 1E-4 );
+
+  // Empty blocks and maps
+  EXPECT_EQ( image.count( 40, 0, 5, 5 ), 0 );
+  EXPECT_EQ( image.count( 0, 0, 0, 5 ), 0 );
+  EXPECT_TRUE( std::isnan( image.mean( -10, -10, 5, 5 ) ) );
+  IntegralImage<Scalar> empty( GridMap<Scalar>( 0, 0 ) );
+  EXPECT_EQ( empty.count( 0, 0, 10, 10 ), 0 );
+}
+
+TYPED_TEST( MapOperations, range_extremum_table )
+{
+  using Scalar = TypeParam;
+  const Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> value_dist( -10, 10 );
+  std::uniform_real_distribution<Scalar> nan_dist( 0, 1 );
+  GridMap<Scalar> map( 45, 38 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x )
+      map( x, y ) = nan_dist( gen ) < 0.3 ? NaN : value_dist( gen );
+  }
+  map.block( 10, 10, 6, 5 ).setConstant( NaN );
+
+  // Small max levels require multiple blocks per query
+  for ( int max_level : { 0, 1, 2, 5, 10 } ) {
+    const RangeMinimumTable<Scalar> minimum_table( map, max_level );
+    const RangeMaximumTable<Scalar> maximum_table( map, max_level );
+    ASSERT_EQ( minimum_table.rows(), map.rows() );
+    ASSERT_EQ( minimum_table.cols(), map.cols() );
+    for ( Eigen::Index x = -3; x < map.rows(); x += 4 ) {
+      for ( Eigen::Index y = -2; y < map.cols(); y += 3 ) {
+        for ( Eigen::Index rows : { 1, 2, 3, 7, 16, 50 } ) {
+          for ( Eigen::Index cols : { 1, 4, 9, 33 } ) {
+            Scalar minimum = NaN, maximum = NaN;
+            for ( Eigen::Index j = std::max<Eigen::Index>( 0, y );
+                  j < std::min( map.cols(), y + cols ); ++j ) {
+              for ( Eigen::Index i = std::max<Eigen::Index>( 0, x );
+                    i < std::min( map.rows(), x + rows ); ++i ) {
+                if ( std::isnan( map( i, j ) ) )
+                  continue;
+                if ( std::isnan( minimum ) || map( i, j ) < minimum )
+                  minimum = map( i, j );
+                if ( std::isnan( maximum ) || map( i, j ) > maximum )
+                  maximum = map( i, j );
+              }
+            }
+            const std::string block = "level " + std::to_string( max_level ) + " block " +
+                                      std::to_string( x ) + ", " + std::to_string( y ) + ", " +
+                                      std::to_string( rows ) + ", " + std::to_string( cols );
+            const Scalar actual_minimum = minimum_table.query( x, y, rows, cols );
+            const Scalar actual_maximum = maximum_table.query( x, y, rows, cols );
+            if ( std::isnan( minimum ) ) {
+              EXPECT_TRUE( std::isnan( actual_minimum ) ) << block;
+              EXPECT_TRUE( std::isnan( actual_maximum ) ) << block;
+              continue;
+            }
+            EXPECT_EQ( actual_minimum, minimum ) << block;
+            EXPECT_EQ( actual_maximum, maximum ) << block;
+          }
+        }
+      }
+    }
+  }
+
+  // The same result as findMinimum and findMaximum for axis-aligned rectangles
+  const RangeMinimumTable<Scalar> minimum_table( map );
+  const RangeMaximumTable<Scalar> maximum_table( map );
+  Polygon<Scalar> rectangle( 2, 4 );
+  rectangle << 3, 30, 30, 3, //
+      5, 5, 25, 25;
+  EXPECT_EQ( minimum_table.query( 3, 5, 27, 20 ), findMinimum<Scalar>( map, rectangle ) );
+  EXPECT_EQ( maximum_table.query( 3, 5, 27, 20 ), findMaximum<Scalar>( map, rectangle ) );
+  EXPECT_LE( minimum_table.size(), 36 * map.size() );
+
+  // The block [10, 16) x [10, 15) is NaN and queries outside of the map are NaN as well
+  EXPECT_TRUE( std::isnan( minimum_table.query( 10, 10, 6, 5 ) ) );
+  EXPECT_TRUE( std::isnan( maximum_table.query( 11, 11, 3, 3 ) ) );
+  EXPECT_TRUE( std::isnan( minimum_table.query( 45, 0, 5, 5 ) ) );
+  EXPECT_TRUE( std::isnan( minimum_table.query( -10, -10, 5, 5 ) ) );
+  const RangeMinimumTable<Scalar> empty( GridMap<Scalar>( 0, 0 ) );
+  EXPECT_TRUE( std::isnan( empty.query( 0, 0, 1, 1 ) ) );
+}
+
 template<typename Scalar>
 GridMap<Scalar> createMap( Eigen::Index rows, Eigen::Index cols, Scalar gradient_x, Scalar gradient_y )
 {
@@ -161,6 +595,72 @@ TYPED_TEST( MapOperations, fitPlane )
   EXPECT_NEAR( result.center_plane_z, 4.5 * 3 - 4.5, 0.1 );
 }
 
+TYPED_TEST( MapOperations, raycastHeightMap )
+{
+  using Scalar = TypeParam;
+  using Vector3S = Vector3<Scalar>;
+  // Flat ground at height 0 with a wall of height 1 at x = 15 (cells 15 and 16) and unknown cells
+  GridMap<Scalar> map = GridMap<Scalar>::Zero( 40, 40 );
+  map.block( 15, 0, 2, 40 ).setConstant( 1 );
+  map.block( 0, 30, 40, 10 ).setConstant( std::numeric_limits<Scalar>::quiet_NaN() );
+  const Scalar resolution = 0.1;
+  const Vector3S origin( 0.55, 1.05, 0.5 );
+
+  // Horizontal ray hits the wall
+  RaycastResult<Scalar> result =
+      raycastHeightMap( map, resolution, origin, Vector3S( 3.5, 1.05, 0.5 ) );
+  ASSERT_TRUE( result.hit );
+  EXPECT_EQ( result.x, 15 );
+  EXPECT_EQ( result.y, 10 );
+  EXPECT_NEAR( result.range, 0.95, 1e-4 );
+  // Ray over the wall doesn't hit anything
+  result = raycastHeightMap( map, resolution, origin, Vector3S( 3.5, 1.05, 3.5 ) );
+  EXPECT_FALSE( result.hit );
+  // Ray ending before the wall doesn't hit anything
+  result = raycastHeightMap( map, resolution, origin, Vector3S( 1.4, 1.05, 0.5 ) );
+  EXPECT_FALSE( result.hit );
+  // Ray descending to the ground hits the ground in the cell where it reaches height 0
+  result = raycastHeightMap( map, resolution, origin, Vector3S( 0.55, 2.05, -0.5 ) );
+  ASSERT_TRUE( result.hit );
+  EXPECT_EQ( result.x, 5 );
+  EXPECT_EQ( result.y, 15 );
+  // Unknown cells are never hit, this ray would reach the ground in the unknown area
+  result =
+      raycastHeightMap( map, resolution, Vector3S( 0.55, 1.05, 2 ), Vector3S( 0.55, 3.95, -0.5 ) );
+  EXPECT_FALSE( result.hit );
+  // Rays leaving the map don't hit anything
+  result = raycastHeightMap( map, resolution, origin, Vector3S( -2, 1.05, 0.5 ) );
+  EXPECT_FALSE( result.hit );
+
+  // The batched version produces the same results in the same order with and without a pool
+  Vector3List<Scalar> ends;
+  for ( int i = 0; i < 500; ++i ) {
+    const double angle = 2 * M_PI * ( ( i * 37 ) % 500 ) / 500.0;
+    ends.emplace_back( origin.x() + 5 * std::cos( angle ), origin.y() + 5 * std::sin( angle ),
+                       0.5 - 0.001 * i );
+  }
+  std::vector<RaycastResult<Scalar>> sequential = raycastHeightMap( map, resolution, origin, ends );
+  ThreadPool pool( 4 );
+  std::vector<RaycastResult<Scalar>> parallel =
+      raycastHeightMap( map, resolution, origin, ends, &pool, 16 );
+  ASSERT_EQ( sequential.size(), ends.size() );
+  ASSERT_EQ( parallel.size(), ends.size() );
+  int hits = 0;
+  for ( size_t i = 0; i < ends.size(); ++i ) {
+    result = raycastHeightMap( map, resolution, origin, ends[i] );
+    EXPECT_EQ( sequential[i].hit, result.hit );
+    EXPECT_EQ( parallel[i].hit, result.hit );
+    if ( !result.hit )
+      continue;
+    ++hits;
+    EXPECT_EQ( sequential[i].x, result.x );
+    EXPECT_EQ( sequential[i].y, result.y );
+    EXPECT_EQ( parallel[i].x, result.x );
+    EXPECT_EQ( parallel[i].y, result.y );
+  }
+  EXPECT_GT( hits, 0 );
+}
+
 int main( int argc, char **argv )
 {
   testing::InitGoogleTest( &argc, argv );
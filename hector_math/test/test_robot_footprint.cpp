@@ -0,0 +1,121 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <hector_math/iterators/polygon_iterator.h>
+#include <hector_math/map_operations/find_minmax.h>
+#include <hector_math/robot/robot_footprint.h>
+
+#include "eigen_tests.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace hector_math;
+
+template<typename Scalar>
+Polygon<Scalar> createFootprint()
+{
+  Polygon<Scalar> footprint( 2, 6 );
+  footprint.col( 0 ) << 0.32, 0.0;
+  footprint.col( 1 ) << 0.2, 0.21;
+  footprint.col( 2 ) << -0.26, 0.19;
+  footprint.col( 3 ) << -0.3, 0.0;
+  footprint.col( 4 ) << -0.26, -0.19;
+  footprint.col( 5 ) << 0.2, -0.21;
+  return footprint;
+}
+
+template<typename Scalar>
+class RobotFootprintTest : public testing::Test
+{
+};
+
+typedef testing::Types<float, double> Implementations;
+
+TYPED_TEST_SUITE( RobotFootprintTest, Implementations );
+
+TYPED_TEST( RobotFootprintTest, stampCache )
+{
+  using Scalar = TypeParam;
+  const Scalar resolution = 0.05;
+  const int directions = 16;
+  const int subdivisions = 4;
+  const Polygon<Scalar> footprint = createFootprint<Scalar>();
+  FootprintStampCache<Scalar> cache( footprint, resolution, directions, subdivisions );
+  EXPECT_EQ( cache.discreteDirection( 0 ), 0 );
+  EXPECT_EQ( cache.discreteDirection( -M_PI / 8 ), 15 );
+  EXPECT_EQ( cache.discreteDirection( 2 * M_PI + M_PI / 8 ), 1 );
+  EXPECT_EQ( cache.discreteDirection( M_PI ), 8 );
+
+  GridMap<Eigen::Index> expected_map( 40, 40 );
+  GridMap<Eigen::Index> actual_map( 40, 40 );
+  for ( int direction = 0; direction < directions; ++direction ) {
+    const Scalar angle = angleFromDirection<Scalar>( direction, directions );
+    const Eigen::Rotation2D<Scalar> rotation( angle );
+    for ( int sub = 0; sub < subdivisions; ++sub ) {
+      // Position at the center of the sub-cell for which the stamp is exact
+      const Vector2<Scalar> pos( ( 17 + ( sub + Scalar( 0.5 ) ) / subdivisions ) * resolution,
+                                 ( 21 + ( sub + Scalar( 0.5 ) ) / subdivisions ) * resolution );
+      const Polygon<Scalar> transformed =
+          ( ( rotation.toRotationMatrix() * footprint.matrix() ).colwise() + pos ).array() /
+          resolution;
+      expected_map.setZero();
+      actual_map.setZero();
+      iteratePolygon( transformed, 40, 40,
+                      [&expected_map]( Eigen::Index x, Eigen::Index y ) { ++expected_map( x, y ); } );
+      cache.iterate( pos, angle, 40, 40,
+                     [&actual_map]( Eigen::Index x, Eigen::Index y ) { ++actual_map( x, y ); } );
+      EXPECT_GT( actual_map.sum(), 50 );
+      EXPECT_TRUE( EIGEN_MATRIX_EQUAL( expected_map, actual_map ) )
+          << "Direction " << direction << ", sub-cell " << sub;
+    }
+  }
+}
+
+TYPED_TEST( RobotFootprintTest, getMinimum )
+{
+  using Scalar = TypeParam;
+  const Scalar resolution = 0.05;
+  const Polygon<Scalar> footprint = createFootprint<Scalar>();
+  PolygonRobotFootprint<Scalar> robot_footprint( footprint, resolution, 32, 1 );
+  const RobotFootprint<Scalar> &base = robot_footprint;
+
+  std::mt19937 gen( 42 );
+  std::uniform_real_distribution<Scalar> dist( -1, 1 );
+  GridMap<Scalar> map( 60, 60 );
+  for ( Eigen::Index i = 0; i < map.size(); ++i ) map( i ) = dist( gen );
+  map.block( 25, 25, 10, 10 ) = std::numeric_limits<Scalar>::quiet_NaN();
+
+  for ( int direction = 0; direction < 32; ++direction ) {
+    const Scalar angle = angleFromDirection<Scalar>( direction, 32 );
+    const Vector2<Scalar> pos( 30.5 * resolution, 28.5 * resolution );
+    const Eigen::Rotation2D<Scalar> rotation( angle );
+    const Polygon<Scalar> transformed =
+        ( ( rotation.toRotationMatrix() * footprint.matrix() ).colwise() + pos ).array() / resolution;
+    EXPECT_EQ( base.getMinimum( map, pos, angle, std::numeric_limits<Scalar>::lowest() ),
+               findMinimum<Scalar>( map, transformed ) )
+        << "Direction " << direction;
+  }
+  // Evaluation stops early once the bound is beaten
+  {
+    const Vector2<Scalar> pos( 12.5 * resolution, 12.5 * resolution );
+    const Scalar minimum =
+        base.getMinimum( map, pos, 0.3, std::numeric_limits<Scalar>::lowest() );
+    const Scalar bound = minimum + Scalar( 0.5 );
+    const Scalar pruned = base.getMinimum( map, pos, 0.3, bound );
+    EXPECT_LT( pruned, bound );
+    EXPECT_GE( pruned, minimum );
+    // If the bound is not beaten, the exact minimum is returned
+    EXPECT_EQ( base.getMinimum( map, pos, 0.3, minimum ), minimum );
+  }
+  // Footprint completely outside of the map
+  EXPECT_TRUE( std::isnan( base.getMinimum( map, Vector2<Scalar>( -2, -2 ), 0, 0 ) ) );
+  // Footprint only contains NaN values
+  map.setConstant( std::numeric_limits<Scalar>::quiet_NaN() );
+  EXPECT_TRUE( std::isnan( base.getMinimum( map, Vector2<Scalar>( 1.5, 1.5 ), 0, 0 ) ) );
+}
+
+int main( int argc, char **argv )
+{
+  testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
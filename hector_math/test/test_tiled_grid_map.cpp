@@ -0,0 +1,59 @@
+// Copyright (c) 2024 Stefan Fabian. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "hector_math/containers/tiled_grid_map.h"
+
+#include "eigen_tests.h"
+#include <gtest/gtest.h>
+
+using namespace hector_math;
+
+template<typename Scalar>
+class TiledGridMapTest : public testing::Test
+{
+};
+
+typedef testing::Types<float, double> Implementations;
+
+TYPED_TEST_SUITE( TiledGridMapTest, Implementations );
+
+TYPED_TEST( TiledGridMapTest, layout )
+{
+  using Scalar = TypeParam;
+  // Sizes that are not a multiple of the tile size
+  GridMap<Scalar> map( 37, 21 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x ) map( x, y ) = Scalar( x + 100 * y );
+  }
+  TiledGridMap<Scalar, 8> tiled( map );
+  ASSERT_EQ( tiled.rows(), 37 );
+  ASSERT_EQ( tiled.cols(), 21 );
+  EXPECT_EQ( tiled.tileRows(), 5 );
+  EXPECT_EQ( tiled.tileCols(), 3 );
+  for ( Eigen::Index y = 0; y < map.cols(); ++y ) {
+    for ( Eigen::Index x = 0; x < map.rows(); ++x ) {
+      ASSERT_EQ( tiled( x, y ), map( x, y ) ) << x << ", " << y;
+    }
+  }
+  EXPECT_TRUE( EIGEN_MATRIX_EQUAL( tiled.toGridMap(), map ) );
+
+  // The cells of a tile are contiguous in column-major order
+  EXPECT_EQ( tiled.data( 17, 9 ) + 1, tiled.data( 18, 9 ) );
+  EXPECT_EQ( tiled.data( 17, 9 ) + 8, tiled.data( 17, 10 ) );
+  EXPECT_EQ( tiled.data( 16, 8 ) + 8 * 8 - 1, tiled.data( 23, 15 ) );
+  EXPECT_EQ( tiled.tile( 2, 1 )( 1, 1 ), map( 17, 9 ) );
+  tiled.tile( 4, 2 )( 4, 4 ) = -1;
+  EXPECT_EQ( tiled( 36, 20 ), -1 );
+
+  tiled( 3, 5 ) = 42;
+  EXPECT_EQ( tiled.toGridMap()( 3, 5 ), 42 );
+  tiled.setConstant( 7 );
+  EXPECT_TRUE( ( tiled.toGridMap() == 7 ).all() );
+
+  TiledGridMap<Scalar> empty;
+  EXPECT_EQ( empty.rows(), 0 );
+  EXPECT_EQ( empty.toGridMap().size(), 0 );
+  empty.resize( 65, 1 );
+  EXPECT_EQ( empty.tileRows(), 2 );
+  EXPECT_EQ( empty.tileCols(), 1 );
+}
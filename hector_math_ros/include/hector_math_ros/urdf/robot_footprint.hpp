@@ -4,20 +4,48 @@
 #ifndef HECTOR_MATH_URDF_ROBOT_FOOTPRINT_H
 #define HECTOR_MATH_URDF_ROBOT_FOOTPRINT_H
 
+#include "hector_math_ros/urdf/robot_model.hpp"
 #include <hector_math/robot/robot_footprint.h>
 
 namespace hector_math
 {
 
+/*!
+ * The footprint of a robot described by an UrdfRobotModel.
+ * The footprint polygon is obtained from the robot model and rasterized masks are precomputed for
+ * a number of discrete orientations and sub-cell offsets (see FootprintStampCache).
+ * Since the footprint of the robot model depends on its joint positions, call update() to
+ * recompute the masks after the joint states of the model changed.
+ */
 template<typename Scalar>
-class UrdfRobotFootprint : public RobotFootprint<Scalar>
+class UrdfRobotFootprint : public PolygonRobotFootprint<Scalar>
 {
 public:
-  Scalar getMinimum( const GridMap<Scalar> &map, const Vector2<Scalar> &pos, Scalar orientation,
-                     Scalar maximum ) const override
+  /*!
+   * @param model The robot model the footprint is obtained from.
+   * @param resolution The resolution of the maps this footprint is evaluated on.
+   * @param directions The number of discrete orientations the masks are precomputed for.
+   * @param subdivisions The number of sub-cell offsets per axis the masks are precomputed for.
+   */
+  UrdfRobotFootprint( typename UrdfRobotModel<Scalar>::ConstPtr model, Scalar resolution,
+                      int directions = 32, int subdivisions = 4 )
+      : PolygonRobotFootprint<Scalar>( model->footprint(), resolution, directions, subdivisions ),
+        model_( std::move( model ) )
   {
-    return 0;
   }
+
+  //! Recomputes the precomputed masks from the current footprint of the robot model.
+  void update()
+  {
+    this->stamps_ = FootprintStampCache<Scalar>( model_->footprint(), this->stamps_.resolution(),
+                                                 this->stamps_.directions(),
+                                                 this->stamps_.subdivisions() );
+  }
+
+  const UrdfRobotModel<Scalar> &robotModel() const { return *model_; }
+
+private:
+  typename UrdfRobotModel<Scalar>::ConstPtr model_;
 };
 } // namespace hector_math
 